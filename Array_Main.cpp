@@ -1,6 +1,11 @@
 #include <iostream>
 #include <iomanip>
 #include "JobMatchingArray.h"
+#include "ShardedMatcher.h"
+#include "QueryServer.h"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 void displayMenu() {
     std::cout << "\n=== Job Matching System (Array Implementation) ===" << std::endl;
@@ -10,11 +15,164 @@ void displayMenu() {
     std::cout << "4. Run Performance Test" << std::endl;
     std::cout << "5. Display Statistics" << std::endl;
     std::cout << "6. Exit" << std::endl;
+    std::cout << "7. Sharded Top-K Query (worker processes)" << std::endl;
+    std::cout << "8. Near-Miss Candidates (missing at most k skills)" << std::endl;
+    std::cout << "9. Filtered Matches (e.g. docker AND (java OR python) AND NOT category:data)" << std::endl;
+    std::cout << "10. Category Prefilter Mode (off / soft / strict)" << std::endl;
+    std::cout << "11. Streaming Matches (resume file read in chunks, not loaded)" << std::endl;
     std::cout << "Choose an option: ";
 }
 
-int main() {
+// Fans one job out to the shard workers and checks the merged ranking against
+// a single-process scan when resumes are loaded locally too.
+void runShardedQuery(JobMatchingSystem& system, ShardedJobMatcher& sharded, bool resumesLoaded) {
+    if (!sharded.isRunning()) {
+        int shardCount;
+        std::cout << "Enter number of shards: ";
+        std::cin >> shardCount;
+        if (!sharded.start("data/resume.csv", shardCount)) {
+            return;
+        }
+    }
+
+    int jobIndex;
+    std::cout << "Enter job index (1 to " << system.getJobCount() << "): ";
+    std::cin >> jobIndex;
+    if (jobIndex < 1 || jobIndex > system.getJobCount()) {
+        std::cout << "Error: Invalid job index" << std::endl;
+        return;
+    }
+
+    const int topN = 5;
+    ScoredIndex merged[topN];
+    clock_t startTime = clock();
+    int found = sharded.findTopMatches(system.getJobDescription(jobIndex - 1), topN, merged);
+    double duration = double(clock() - startTime) / CLOCKS_PER_SEC;
+    if (found < 0) {
+        std::cout << "Error: one or more shards failed" << std::endl;
+        return;
+    }
+
+    std::cout << "\nTop " << topN << " Matches across " << sharded.getShardCount() << " shards:" << std::endl;
+    for (int i = 0; i < found; i++) {
+        std::cout << i + 1 << ". Resume " << merged[i].index + 1 << " - Score: "
+                  << std::fixed << std::setprecision(2) << merged[i].score << "%" << std::endl;
+    }
+    std::cout << "Coordinator time: " << duration << " seconds" << std::endl;
+
+    if (resumesLoaded) {
+        ScoredIndex local[topN];
+        int localFound = system.topMatchesForJobText(system.getJobDescription(jobIndex - 1), topN, local);
+        bool same = (localFound == found);
+        for (int i = 0; same && i < found; i++) {
+            same = local[i].index == merged[i].index && local[i].score == merged[i].score;
+        }
+        std::cout << "Matches single-process ranking: " << (same ? "yes" : "NO") << std::endl;
+    }
+}
+
+// Matches jobs [firstJob, firstJob + jobCount) against a resume file streamed
+// chunk by chunk; returns false if the file could not be read
+bool runStreamingMatches(JobMatchingSystem& system, const std::string& filename,
+                         int firstJob, int jobCount, int topN, bool resumesLoaded) {
+    if (firstJob < 0 || jobCount < 1 || firstJob + jobCount > system.getJobCount() || topN < 1) {
+        std::cout << "Error: Invalid job range" << std::endl;
+        return false;
+    }
+
+    int* jobIndices = new int[jobCount];
+    for (int j = 0; j < jobCount; j++) jobIndices[j] = firstJob + j;
+    ScoredIndex* results = new ScoredIndex[jobCount * topN];
+    int* resultCounts = new int[jobCount];
+
+    clock_t startTime = clock();
+    long long rows = system.findBestMatchesStreaming(filename, jobIndices, jobCount, topN, results, resultCounts);
+    double duration = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+    if (rows >= 0) {
+        for (int j = 0; j < jobCount; j++) {
+            std::cout << "\nTop " << topN << " Matches for Job " << jobIndices[j] + 1 << ":" << std::endl;
+            for (int i = 0; i < resultCounts[j]; i++) {
+                const ScoredIndex& match = results[j * topN + i];
+                std::cout << i + 1 << ". Resume " << match.index + 1 << " - Score: "
+                          << std::fixed << std::setprecision(2) << match.score << "%" << std::endl;
+            }
+        }
+        std::cout << "\nStreamed " << rows << " resumes against " << jobCount << " jobs in "
+                  << std::setprecision(3) << duration << " seconds ("
+                  << std::setprecision(0) << (duration > 0 ? rows / duration : 0.0) << " resumes/s)" << std::endl;
+
+        if (resumesLoaded) {
+            ScoredIndex* local = new ScoredIndex[jobCount * topN];
+            int* localCounts = new int[jobCount];
+            system.findBestMatchesBatch(jobIndices, jobCount, topN, local, localCounts);
+            bool same = true;
+            for (int j = 0; same && j < jobCount; j++) {
+                same = localCounts[j] == resultCounts[j];
+                for (int i = 0; same && i < resultCounts[j]; i++) {
+                    same = local[j * topN + i].index == results[j * topN + i].index &&
+                           local[j * topN + i].score == results[j * topN + i].score;
+                }
+            }
+            std::cout << "Matches in-memory ranking: " << (same ? "yes" : "NO") << std::endl;
+            delete[] local;
+            delete[] localCounts;
+        }
+    }
+
+    delete[] jobIndices;
+    delete[] results;
+    delete[] resultCounts;
+    return rows >= 0;
+}
+
+// Non-interactive modes:
+//   Array_Main --serve [socketPath]                      keep the index resident and answer queries
+//   Array_Main --load-test [clients] [requests] [path]   built-in load generator against a local server
+//   Array_Main --stream [resumeFile] [jobs] [k]          top-K for the first jobs without loading resumes
+int runServerMode(int argc, char* argv[]) {
+    JobMatchingSystem system;
+    if (std::strcmp(argv[1], "--stream") == 0) {
+        std::string filename = argc > 2 ? argv[2] : "data/resume.csv";
+        int jobCount = argc > 3 ? std::atoi(argv[3]) : 10;
+        int k = argc > 4 ? std::atoi(argv[4]) : 5;
+        if (!system.loadJobsFromCSV("data/job_description.csv")) {
+            return 1;
+        }
+        return runStreamingMatches(system, filename, 0, std::min(jobCount, system.getJobCount()), k, false) ? 0 : 1;
+    }
+
+    if (!system.loadJobsFromCSV("data/job_description.csv") ||
+        !system.loadResumesFromCSV("data/resume.csv")) {
+        return 1;
+    }
+
+    if (std::strcmp(argv[1], "--serve") == 0) {
+        std::string path = argc > 2 ? argv[2] : "/tmp/job_matching.sock";
+        JobQueryServer server(system);
+        if (!server.listenOn(path)) {
+            return 1;
+        }
+        std::cout << "Serving top-K queries on " << path << std::endl;
+        server.run();
+        return 0;
+    }
+
+    int clients = argc > 2 ? std::atoi(argv[2]) : 16;
+    int requests = argc > 3 ? std::atoi(argv[3]) : 200;
+    std::string path = argc > 4 ? argv[4] : "/tmp/job_matching_load.sock";
+    runServerLoadTest(system, path, clients, requests, 5);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && (std::strcmp(argv[1], "--serve") == 0 || std::strcmp(argv[1], "--load-test") == 0 ||
+                     std::strcmp(argv[1], "--stream") == 0)) {
+        return runServerMode(argc, argv);
+    }
+
     JobMatchingSystem system;
+    ShardedJobMatcher sharded;
     int choice;
     bool jobsLoaded = false;
     bool resumesLoaded = false;
@@ -62,7 +220,75 @@ int main() {
                 std::cout << "\n=== System Statistics ===" << std::endl;
                 std::cout << "Jobs loaded: " << system.getJobCount() << std::endl;
                 std::cout << "Resumes loaded: " << system.getResumeCount() << std::endl;
+                system.displayIndexStats();
+                break;
+                
+            case 7:
+                if (!jobsLoaded) {
+                    std::cout << "Error: Please load job descriptions first" << std::endl;
+                    break;
+                }
+                runShardedQuery(system, sharded, resumesLoaded);
+                break;
+                
+            case 8: {
+                if (!jobsLoaded || !resumesLoaded) {
+                    std::cout << "Error: Please load both jobs and resumes first" << std::endl;
+                    break;
+                }
+                int jobIndex, maxMissing;
+                std::cout << "Enter job index (1 to " << system.getJobCount() << "): ";
+                std::cin >> jobIndex;
+                std::cout << "Maximum missing skills: ";
+                std::cin >> maxMissing;
+                system.findNearMissMatches(jobIndex - 1, maxMissing);
+                break;
+            }
+                
+            case 9: {
+                if (!jobsLoaded || !resumesLoaded) {
+                    std::cout << "Error: Please load both jobs and resumes first" << std::endl;
+                    break;
+                }
+                int jobIndex;
+                std::string filter;
+                std::cout << "Enter job index (1 to " << system.getJobCount() << "): ";
+                std::cin >> jobIndex;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Filter: ";
+                std::getline(std::cin, filter);
+                system.findBestMatchesFiltered(jobIndex - 1, filter);
+                break;
+            }
+                
+            case 10: {
+                const char* modeNames[] = {"off", "soft", "strict"};
+                int mode;
+                std::cout << "Current mode: " << modeNames[system.getCategoryFilter()] << std::endl;
+                std::cout << "Enter mode (0 = off, 1 = soft, 2 = strict): ";
+                std::cin >> mode;
+                if (mode < 0 || mode > 2) {
+                    std::cout << "Invalid mode." << std::endl;
+                    break;
+                }
+                system.setCategoryFilter(static_cast<CategoryFilterMode>(mode));
+                std::cout << "Category prefilter: " << modeNames[mode] << std::endl;
+                break;
+            }
+                
+            case 11: {
+                if (!jobsLoaded) {
+                    std::cout << "Error: Please load job descriptions first" << std::endl;
+                    break;
+                }
+                int firstJob, jobCount;
+                std::cout << "Enter first job index (1 to " << system.getJobCount() << "): ";
+                std::cin >> firstJob;
+                std::cout << "Number of jobs: ";
+                std::cin >> jobCount;
+                runStreamingMatches(system, "data/resume.csv", firstJob - 1, jobCount, 5, resumesLoaded);
                 break;
+            }
                 
             case 6:
                 std::cout << "Exiting system. Goodbye!" << std::endl;
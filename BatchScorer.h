@@ -0,0 +1,359 @@
+#ifndef BATCH_SCORER_H
+#define BATCH_SCORER_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BATCH_SCORER_X86 1
+#endif
+
+// Compact skill encoding: every distinct skill of the dictionary owns one bit of
+// a 64-bit mask. Resume masks are stored as structure-of-arrays (low and high
+// 32-bit words in separate arrays) so one vector load covers 8 or 16 resumes.
+const int MAX_ENCODED_SKILLS = 64;
+
+class SkillMaskArray {
+private:
+    uint32_t* lo;
+    uint32_t* hi;
+    int capacity;
+    int size;
+
+    void resize() {
+        capacity *= 2;
+        uint32_t* newLo = new uint32_t[capacity];
+        uint32_t* newHi = new uint32_t[capacity];
+        std::memcpy(newLo, lo, sizeof(uint32_t) * size);
+        std::memcpy(newHi, hi, sizeof(uint32_t) * size);
+        delete[] lo;
+        delete[] hi;
+        lo = newLo;
+        hi = newHi;
+    }
+
+public:
+    SkillMaskArray() : capacity(16), size(0) {
+        lo = new uint32_t[capacity];
+        hi = new uint32_t[capacity];
+    }
+
+    SkillMaskArray(const SkillMaskArray& other) : capacity(other.capacity), size(other.size) {
+        lo = new uint32_t[capacity];
+        hi = new uint32_t[capacity];
+        std::memcpy(lo, other.lo, sizeof(uint32_t) * size);
+        std::memcpy(hi, other.hi, sizeof(uint32_t) * size);
+    }
+
+    SkillMaskArray& operator=(const SkillMaskArray& other) {
+        if (this != &other) {
+            delete[] lo;
+            delete[] hi;
+            capacity = other.capacity;
+            size = other.size;
+            lo = new uint32_t[capacity];
+            hi = new uint32_t[capacity];
+            std::memcpy(lo, other.lo, sizeof(uint32_t) * size);
+            std::memcpy(hi, other.hi, sizeof(uint32_t) * size);
+        }
+        return *this;
+    }
+
+    ~SkillMaskArray() {
+        delete[] lo;
+        delete[] hi;
+    }
+
+    void add(uint64_t mask) {
+        if (size >= capacity) {
+            resize();
+        }
+        lo[size] = static_cast<uint32_t>(mask);
+        hi[size] = static_cast<uint32_t>(mask >> 32);
+        size++;
+    }
+
+    uint64_t get(int index) const {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return (static_cast<uint64_t>(hi[index]) << 32) | lo[index];
+    }
+
+    const uint32_t* lowWords() const { return lo; }
+    const uint32_t* highWords() const { return hi; }
+
+    int getSize() const {
+        return size;
+    }
+
+    void clear() {
+        size = 0;
+    }
+};
+
+// One byte per document: bit c is set when the document has a skill of category c
+class CategoryMaskArray {
+private:
+    uint8_t* data;
+    int capacity;
+    int size;
+
+    void resize() {
+        capacity *= 2;
+        uint8_t* newData = new uint8_t[capacity];
+        std::memcpy(newData, data, size);
+        delete[] data;
+        data = newData;
+    }
+
+public:
+    CategoryMaskArray() : capacity(16), size(0) {
+        data = new uint8_t[capacity];
+    }
+
+    CategoryMaskArray(const CategoryMaskArray& other) : capacity(other.capacity), size(other.size) {
+        data = new uint8_t[capacity];
+        std::memcpy(data, other.data, size);
+    }
+
+    CategoryMaskArray& operator=(const CategoryMaskArray& other) {
+        if (this != &other) {
+            delete[] data;
+            capacity = other.capacity;
+            size = other.size;
+            data = new uint8_t[capacity];
+            std::memcpy(data, other.data, size);
+        }
+        return *this;
+    }
+
+    ~CategoryMaskArray() {
+        delete[] data;
+    }
+
+    void add(uint8_t mask) {
+        if (size >= capacity) {
+            resize();
+        }
+        data[size++] = mask;
+    }
+
+    const uint8_t* masks() const { return data; }
+
+    int getSize() const {
+        return size;
+    }
+
+    void clear() {
+        size = 0;
+    }
+};
+
+// A job reduced to its distinct required skills. Duplicated skills (for example
+// "agile" listed under two categories) keep their multiplicity in `count`, so the
+// kernels reproduce calculateWeightedScore exactly, including its bonus rules.
+struct EncodedJob {
+    struct Term {
+        int word;        // 0 = low mask word, 1 = high mask word
+        uint32_t bit;    // bit of the skill inside that word
+        int count;       // how many times the job lists the skill
+        float delta;     // score change between "missing" and "matched"
+    };
+
+    Term terms[MAX_ENCODED_SKILLS];
+    int termCount;
+    int totalCount;      // jobSkills.getSize() in the reference scorer
+    float maxWeight;     // sum of weights over every listed skill
+    float missingAcc;    // weighted total when no skill matches (all penalties)
+    uint64_t skillMask;
+
+    EncodedJob() : termCount(0), totalCount(0), maxWeight(0.0f), missingAcc(0.0f), skillMask(0) {}
+
+    void addSkill(int skillId, int count, double weight) {
+        if (skillId < 0 || skillId >= MAX_ENCODED_SKILLS || count <= 0) {
+            return;
+        }
+        Term& t = terms[termCount++];
+        t.word = skillId / 32;
+        t.bit = 1u << (skillId % 32);
+        t.count = count;
+        t.delta = static_cast<float>(count * weight * 1.3);
+        totalCount += count;
+        maxWeight += static_cast<float>(count * weight);
+        missingAcc -= static_cast<float>(count * weight * 0.3);
+        skillMask |= 1ull << skillId;
+    }
+};
+
+namespace BatchScorer {
+
+    // Penalty, clamp and bonus rules of calculateWeightedScore applied to one lane
+    inline float finishScore(const EncodedJob& job, float acc, int matches) {
+        if (job.totalCount == 0 || job.maxWeight == 0.0f) {
+            return 0.0f;
+        }
+        float score = acc * (100.0f / job.maxWeight);
+        score = score < 0.0f ? 0.0f : (score > 100.0f ? 100.0f : score);
+        if (matches * 5 >= job.totalCount * 4) {
+            float boosted = score * 1.1f;
+            score = boosted < 95.0f ? boosted : 95.0f;
+        }
+        if (matches == job.totalCount) {
+            return 100.0f;
+        }
+        return score;
+    }
+
+    // Scalar reference kernel, also used for the tail of every vector kernel
+    inline void scoreBlockScalar(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                                 int count, float* out) {
+        for (int i = 0; i < count; i++) {
+            float acc = job.missingAcc;
+            int matches = 0;
+            for (int t = 0; t < job.termCount; t++) {
+                const EncodedJob::Term& term = job.terms[t];
+                uint32_t word = term.word ? hi[i] : lo[i];
+                if (word & term.bit) {
+                    acc += term.delta;
+                    matches += term.count;
+                }
+            }
+            out[i] = finishScore(job, acc, matches);
+        }
+    }
+
+#ifdef BATCH_SCORER_X86
+    // 8 resumes per iteration
+    __attribute__((target("avx2")))
+    inline void scoreBlockAVX2(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                               int count, float* out) {
+        if (job.totalCount == 0 || job.maxWeight == 0.0f) {
+            for (int i = 0; i < count; i++) out[i] = 0.0f;
+            return;
+        }
+
+        const __m256 scale = _mm256_set1_ps(100.0f / job.maxWeight);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 hundred = _mm256_set1_ps(100.0f);
+        const __m256 bonusFactor = _mm256_set1_ps(1.1f);
+        const __m256 bonusCap = _mm256_set1_ps(95.0f);
+        const __m256i total = _mm256_set1_epi32(job.totalCount);
+        const __m256i bonusLimit = _mm256_set1_epi32(job.totalCount * 4 - 1);
+        const __m256i five = _mm256_set1_epi32(5);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i words[2] = {
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hi + i))
+            };
+            __m256 acc = _mm256_set1_ps(job.missingAcc);
+            __m256i matches = _mm256_setzero_si256();
+
+            for (int t = 0; t < job.termCount; t++) {
+                const EncodedJob::Term& term = job.terms[t];
+                __m256i bit = _mm256_set1_epi32(static_cast<int>(term.bit));
+                __m256i present = _mm256_cmpeq_epi32(_mm256_and_si256(words[term.word], bit), bit);
+                acc = _mm256_add_ps(acc, _mm256_and_ps(_mm256_castsi256_ps(present), _mm256_set1_ps(term.delta)));
+                matches = _mm256_add_epi32(matches, _mm256_and_si256(present, _mm256_set1_epi32(term.count)));
+            }
+
+            __m256 score = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(acc, scale), zero), hundred);
+            __m256i bonus = _mm256_cmpgt_epi32(_mm256_mullo_epi32(matches, five), bonusLimit);
+            __m256 boosted = _mm256_min_ps(_mm256_mul_ps(score, bonusFactor), bonusCap);
+            score = _mm256_blendv_ps(score, boosted, _mm256_castsi256_ps(bonus));
+            __m256i perfect = _mm256_cmpeq_epi32(matches, total);
+            score = _mm256_blendv_ps(score, hundred, _mm256_castsi256_ps(perfect));
+            _mm256_storeu_ps(out + i, score);
+        }
+
+        scoreBlockScalar(job, lo + i, hi + i, count - i, out + i);
+    }
+
+    // 16 resumes per iteration
+    __attribute__((target("avx512f")))
+    inline void scoreBlockAVX512(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                                 int count, float* out) {
+        if (job.totalCount == 0 || job.maxWeight == 0.0f) {
+            for (int i = 0; i < count; i++) out[i] = 0.0f;
+            return;
+        }
+
+        const __m512 scale = _mm512_set1_ps(100.0f / job.maxWeight);
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 hundred = _mm512_set1_ps(100.0f);
+        const __m512 bonusFactor = _mm512_set1_ps(1.1f);
+        const __m512 bonusCap = _mm512_set1_ps(95.0f);
+        const __m512i total = _mm512_set1_epi32(job.totalCount);
+        const __m512i bonusLimit = _mm512_set1_epi32(job.totalCount * 4);
+        const __m512i five = _mm512_set1_epi32(5);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512i words[2] = {
+                _mm512_loadu_si512(lo + i),
+                _mm512_loadu_si512(hi + i)
+            };
+            __m512 acc = _mm512_set1_ps(job.missingAcc);
+            __m512i matches = _mm512_setzero_si512();
+
+            for (int t = 0; t < job.termCount; t++) {
+                const EncodedJob::Term& term = job.terms[t];
+                __mmask16 present = _mm512_test_epi32_mask(words[term.word],
+                                                           _mm512_set1_epi32(static_cast<int>(term.bit)));
+                acc = _mm512_mask_add_ps(acc, present, acc, _mm512_set1_ps(term.delta));
+                matches = _mm512_mask_add_epi32(matches, present, matches, _mm512_set1_epi32(term.count));
+            }
+
+            // maskz forms avoid GCC's spurious uninitialized warning on _mm512_min_ps/_mm512_max_ps
+            __m512 score = _mm512_maskz_min_ps(0xFFFF, _mm512_maskz_max_ps(0xFFFF, _mm512_mul_ps(acc, scale), zero), hundred);
+            __mmask16 bonus = _mm512_cmpge_epi32_mask(_mm512_mullo_epi32(matches, five), bonusLimit);
+            score = _mm512_mask_min_ps(score, bonus, _mm512_mul_ps(score, bonusFactor), bonusCap);
+            __mmask16 perfect = _mm512_cmpeq_epi32_mask(matches, total);
+            score = _mm512_mask_mov_ps(score, perfect, hundred);
+            _mm512_storeu_ps(out + i, score);
+        }
+
+        scoreBlockScalar(job, lo + i, hi + i, count - i, out + i);
+    }
+#endif
+
+    typedef void (*ScoreBlockFn)(const EncodedJob&, const uint32_t*, const uint32_t*, int, float*);
+
+    struct ScoreKernel {
+        const char* name;
+        ScoreBlockFn score;
+    };
+
+    // Picks the widest kernel the CPU supports; CPUID is queried once per process
+    inline const ScoreKernel& selectedKernel() {
+        static const ScoreKernel kernel = []() {
+#ifdef BATCH_SCORER_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return ScoreKernel{"avx512", scoreBlockAVX512};
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return ScoreKernel{"avx2", scoreBlockAVX2};
+            }
+#endif
+            return ScoreKernel{"scalar", scoreBlockScalar};
+        }();
+        return kernel;
+    }
+
+    inline const ScoreKernel& scalarKernel() {
+        static const ScoreKernel kernel = {"scalar", scoreBlockScalar};
+        return kernel;
+    }
+
+    inline void scoreBlock(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                           int count, float* out) {
+        selectedKernel().score(job, lo, hi, count, out);
+    }
+}
+
+#endif
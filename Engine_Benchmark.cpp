@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+#include <cstdlib>
+#include "MatchingEngine.h"
+
+// Runs the same load + top-K workload through MatchingEngine with every storage
+// policy, once with the array program's dictionary and formula and once with
+// the linked-list program's, so layouts are compared on identical work.
+//
+//   Engine_Benchmark [jobs] [rounds]
+
+const int TOP_N = 5;
+
+struct BenchmarkResult {
+    double loadSeconds;
+    double querySeconds;
+    ScoredIndex* results;   // jobCount * TOP_N
+    int* counts;            // jobCount
+};
+
+template <typename Storage, typename Dictionary, typename Scoring>
+BenchmarkResult runEngine(int jobCount, int rounds) {
+    typedef MatchingEngine<Storage, Dictionary, Scoring> Engine;
+    BenchmarkResult result = {0.0, 0.0, new ScoredIndex[jobCount * TOP_N], new int[jobCount]};
+    for (int j = 0; j < jobCount; j++) result.counts[j] = 0;
+
+    Engine engine;
+    clock_t startTime = clock();
+    if (!engine.loadJobs("data/job_description.csv") || !engine.loadResumes("data/resume.csv")) {
+        return result;
+    }
+    result.loadSeconds = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+    if (jobCount > engine.getJobCount()) jobCount = engine.getJobCount();
+    startTime = clock();
+    for (int round = 0; round < rounds; round++) {
+        for (int j = 0; j < jobCount; j++) {
+            result.counts[j] = engine.topMatches(j, TOP_N, result.results + j * TOP_N);
+        }
+    }
+    result.querySeconds = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+    std::cout << std::left << std::setw(42) << Engine::describe() << std::right
+              << " load " << std::fixed << std::setprecision(3) << std::setw(7) << result.loadSeconds << " s"
+              << "   query " << std::setw(8) << result.querySeconds * 1000.0 / (rounds * jobCount) << " ms/job"
+              << std::endl;
+    return result;
+}
+
+bool sameResults(const BenchmarkResult& a, const BenchmarkResult& b, int jobCount) {
+    for (int j = 0; j < jobCount; j++) {
+        if (a.counts[j] != b.counts[j]) return false;
+        for (int i = 0; i < a.counts[j]; i++) {
+            const ScoredIndex& x = a.results[j * TOP_N + i];
+            const ScoredIndex& y = b.results[j * TOP_N + i];
+            if (x.index != y.index || x.score != y.score) return false;
+        }
+    }
+    return true;
+}
+
+void release(BenchmarkResult& result) {
+    delete[] result.results;
+    delete[] result.counts;
+}
+
+template <typename Dictionary, typename Scoring>
+void runConfiguration(const char* title, int jobCount, int rounds) {
+    std::cout << "\n=== " << title << " ===" << std::endl;
+    BenchmarkResult array = runEngine<ArrayStorage, Dictionary, Scoring>(jobCount, rounds);
+    BenchmarkResult list = runEngine<ListStorage, Dictionary, Scoring>(jobCount, rounds);
+    BenchmarkResult unrolled = runEngine<UnrolledStorage<32>, Dictionary, Scoring>(jobCount, rounds);
+    BenchmarkResult mapped = runEngine<MappedStorage, Dictionary, Scoring>(jobCount, rounds);
+
+    bool same = sameResults(array, list, jobCount) && sameResults(array, unrolled, jobCount) &&
+                sameResults(array, mapped, jobCount);
+    std::cout << "Identical top " << TOP_N << " across storages: " << (same ? "yes" : "NO") << std::endl;
+
+    std::cout << "Job 1:";
+    for (int i = 0; i < array.counts[0]; i++) {
+        std::cout << " resume " << array.results[i].index + 1 << " ("
+                  << std::setprecision(2) << array.results[i].score << "%)";
+    }
+    std::cout << std::endl;
+
+    release(array);
+    release(list);
+    release(unrolled);
+    release(mapped);
+}
+
+int main(int argc, char* argv[]) {
+    int jobCount = argc > 1 ? std::atoi(argv[1]) : 10;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (jobCount < 1 || rounds < 1) {
+        std::cout << "Error: jobs and rounds must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Matching engine benchmark: " << jobCount << " jobs, top " << TOP_N
+              << ", " << rounds << " rounds" << std::endl;
+    runConfiguration<CategorySkillDictionary, WeightedScoring>("Weighted scoring, category skills (array program)",
+                                                              jobCount, rounds);
+    runConfiguration<KeywordDictionary, KeywordScoring>("Keyword scoring, keywords (linked-list program)",
+                                                        jobCount, rounds);
+    return 0;
+}
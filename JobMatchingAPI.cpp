@@ -0,0 +1,93 @@
+#include "JobMatchingAPI.h"
+#include "JobMatchingArray.h"
+#include <cstddef>
+#include <new>
+
+// The library translation unit: JobMatchingSystem behind the C functions of
+// JobMatchingAPI.h. Every entry point catches C++ exceptions and reports -1/NULL.
+
+struct jm_index {
+    JobMatchingSystem system;
+};
+
+// Results are sorted straight into the caller's array
+static_assert(sizeof(jm_match) == sizeof(ScoredIndex) &&
+              offsetof(jm_match, resume_index) == offsetof(ScoredIndex, index) &&
+              offsetof(jm_match, score) == offsetof(ScoredIndex, score),
+              "jm_match must match the layout of ScoredIndex");
+
+extern "C" {
+
+jm_index* jm_create(const char* jobs_csv, size_t jobs_length,
+                    const char* resumes_csv, size_t resumes_length) {
+    jm_index* index = NULL;
+    try {
+        index = new jm_index();
+        if (jobs_csv) {
+            index->system.loadJobsFromBuffer(jobs_csv, jobs_length);
+        }
+        if (resumes_csv) {
+            index->system.loadResumesFromBuffer(resumes_csv, resumes_length);
+        }
+        return index;
+    } catch (...) {
+        delete index;
+        return NULL;
+    }
+}
+
+int jm_add_job(jm_index* index, const char* text, size_t length) {
+    if (!index || (!text && length > 0)) return -1;
+    try {
+        index->system.addJob(std::string(text ? text : "", length));
+        return index->system.getJobCount() - 1;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int jm_add_resume(jm_index* index, const char* text, size_t length) {
+    if (!index || (!text && length > 0)) return -1;
+    try {
+        index->system.addResume(std::string(text ? text : "", length));
+        return index->system.getResumeCount() - 1;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int jm_job_count(const jm_index* index) {
+    return index ? index->system.getJobCount() : -1;
+}
+
+int jm_resume_count(const jm_index* index) {
+    return index ? index->system.getResumeCount() : -1;
+}
+
+int jm_top_matches(jm_index* index, int job_index, int k, jm_match* out) {
+    if (!index || k < 0 || (!out && k > 0)) return -1;
+    if (job_index < 0 || job_index >= index->system.getJobCount()) return -1;
+    try {
+        return index->system.topMatchesForJobText(index->system.getJobDescription(job_index), k,
+                                                  reinterpret_cast<ScoredIndex*>(out));
+    } catch (...) {
+        return -1;
+    }
+}
+
+int jm_top_matches_for_text(jm_index* index, const char* job_text, size_t length,
+                            int k, jm_match* out) {
+    if (!index || k < 0 || (!out && k > 0) || (!job_text && length > 0)) return -1;
+    try {
+        return index->system.topMatchesForJobText(std::string(job_text ? job_text : "", length), k,
+                                                  reinterpret_cast<ScoredIndex*>(out));
+    } catch (...) {
+        return -1;
+    }
+}
+
+void jm_free(jm_index* index) {
+    delete index;
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef JOB_MATCHING_API_H
+#define JOB_MATCHING_API_H
+
+/* C interface to the array job matcher (JobMatchingArray.h), for linking the
+ * matcher into other programs as a static or shared library instead of running
+ * Array_Main. Build: see README.md.
+ *
+ * Indices are 0-based. Functions that return int return -1 on error (bad
+ * argument, out of memory, invalid index); no error ever escapes as a C++
+ * exception. A jm_index must not be used from two threads at once. */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct jm_index jm_index;
+
+/* One ranked resume; results are ordered by score (desc), then index (asc) */
+typedef struct jm_match {
+    int resume_index;
+    float score;
+} jm_match;
+
+/* Creates an index from CSV bytes in memory (one row per line, header row
+ * skipped, LF or CRLF line endings, surrounding quotes removed). Either
+ * buffer may be NULL to start empty. The buffers are not referenced after
+ * the call. NULL on failure. */
+jm_index* jm_create(const char* jobs_csv, size_t jobs_length,
+                    const char* resumes_csv, size_t resumes_length);
+
+/* Adds one document; returns its index */
+int jm_add_job(jm_index* index, const char* text, size_t length);
+int jm_add_resume(jm_index* index, const char* text, size_t length);
+
+int jm_job_count(const jm_index* index);
+int jm_resume_count(const jm_index* index);
+
+/* Writes the best `k` resumes with a positive score for a loaded job, or for
+ * an arbitrary job text, into `out` (room for `k` entries). Returns the number
+ * of entries written. Nothing is allocated per result. */
+int jm_top_matches(jm_index* index, int job_index, int k, jm_match* out);
+int jm_top_matches_for_text(jm_index* index, const char* job_text, size_t length,
+                            int k, jm_match* out);
+
+/* Releases the index; NULL is allowed */
+void jm_free(jm_index* index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
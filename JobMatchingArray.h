@@ -8,7 +8,16 @@
 #include <cmath>
 #include <ctime>
 #include <iomanip>  
+#include <algorithm>
 #include <stdexcept> 
+#include <cstring>
+#include <limits>
+#include "BatchScorer.h"
+#include "TopK.h"
+#include "SkillPostings.h"
+#include "SkillFilter.h"
+#include "TextStore.h"
+#include "SkillDictionary.h"
 
 class DynamicArray {
 private:
@@ -98,153 +107,84 @@ public:
     }
 };
 
+// First-stage filter on SkillCategory::category. SOFT keeps resumes sharing at
+// least one of the job's non-general categories, STRICT only resumes covering
+// all of them. Jobs with only general skills are never filtered.
+enum CategoryFilterMode {
+    CATEGORY_FILTER_OFF,
+    CATEGORY_FILTER_SOFT,
+    CATEGORY_FILTER_STRICT
+};
+
 class JobMatchingSystem {
 private:
     DynamicArray jobDescriptions;
-    DynamicArray resumeDescriptions;
-    
-    // Common skills dictionary
-    struct SkillCategory {
-        std::string skill;
-        std::string category;
-        double weight;
-    };
-    
-    SkillCategory skillCategories[100] = {
-        // Data Analyst Skills
-        {"sql", "data", 1.5},
-        {"excel", "data", 1.3},
-        {"power bi", "data", 1.4},
-        {"tableau", "data", 1.4},
-        {"data cleaning", "data", 1.2},
-        {"data analysis", "data", 1.3},
-        {"reporting", "data", 1.1},
-        {"statistics", "data", 1.2},
-        {"data visualization", "data", 1.3},
-        {"dashboards", "data", 1.1},
-        
-        // Data Scientist Skills
-        {"python", "data_science", 1.6},
-        {"machine learning", "data_science", 2.0},
-        {"deep learning", "data_science", 2.0},
-        {"nlp", "data_science", 1.8},
-        {"pandas", "data_science", 1.5},
-        {"numpy", "data_science", 1.4},
-        {"tensorflow", "data_science", 1.8},
-        {"pytorch", "data_science", 1.8},
-        {"keras", "data_science", 1.7},
-        {"scikit-learn", "data_science", 1.6},
-        
-        // Software Engineering Skills
-        {"java", "engineering", 1.5},
-        {"spring boot", "engineering", 1.6},
-        {"docker", "engineering", 1.4},
-        {"kubernetes", "engineering", 1.5},
-        {"rest apis", "engineering", 1.3},
-        {"microservices", "engineering", 1.4},
-        {"system design", "engineering", 1.5},
-        {"git", "engineering", 1.1},
-        {"agile", "engineering", 1.1},
-        {"ci/cd", "engineering", 1.3},
-        
-        // Machine Learning Engineer Skills
-        {"mlops", "ml_engineering", 1.6},
-        {"computer vision", "ml_engineering", 1.8},
-        {"cloud", "ml_engineering", 1.5},
-        {"model deployment", "ml_engineering", 1.4},
-        {"tensorflow serving", "ml_engineering", 1.5},
-        {"pytorch lightning", "ml_engineering", 1.5},
-        {"data pipelines", "ml_engineering", 1.3},
-
-        // Product Manager Skills
-        {"agile", "product_management", 1.3},
-        {"scrum", "product_management", 1.3},
-        {"stakeholder management", "product_management", 1.4},
-        {"user stories", "product_management", 1.3},
-        {"product roadmap", "product_management", 1.5},
-        {"requirements gathering", "product_management", 1.2},
-        {"ui/ux", "product_management", 1.1},
-        {"communication", "product_management", 1.0},
-        {"team leadership", "product_management", 1.0},
-
-        // Soft Skills
-        {"communication", "general", 1.0},
-        {"time management", "general", 1.1},
-        {"adaptability", "general", 1.0},
-        {"project management", "general", 1.1},
-        {"presentation", "general", 1.0},
-        {"leadership", "general", 1.0},
-        {"collaboration", "general", 1.0},
-        {"problem solving", "general", 1.2}
-    };
+    LazyTextStore resumeTexts;   // previews resident, full text read from the CSV on demand
+    SkillDictionary dictionary;
 
-    struct SkillSynonym {
-        std::string canonical;
-        std::string variants[3]; // up to 3 synonyms
-    };
+    // Compact skill encoding (see BatchScorer.h) and category of every resume
+    SkillMaskArray resumeSkillMasks;
+    SkillPostings skillPostings;
+    CategoryMaskArray resumeCategoryMasks;
+    CategoryFilterMode categoryFilter = CATEGORY_FILTER_OFF;
+    bool quietLoading = false;       // loaders print nothing; callers check the result
 
-    SkillSynonym skillSynonyms[10] = {
-        {"rest apis", {"rest api", "restful apis", "restful api"}},
-        {"mlops", {"machine learning ops", "ml operations"}},
-        {"power bi", {"powerbi", "ms power bi"}},
-        {"git", {"version control"}},
-        {"excel", {"microsoft excel", "spreadsheets"}},
-        {"ci/cd", {"continuous integration", "continuous delivery"}}
-    };
+    DynamicArray extractSkills(const std::string& text) {
+        DynamicArray skills;
+        dictionary.forEachSkill(text, [&](int id) { skills.add(dictionary.skillName(id)); });
+        return skills;
+    }
 
-    double calculateSkillWeight(const std::string& skill) {
-        for (int i = 0; i < 100; i++) {
-            if (skillCategories[i].skill == skill) {
-                return skillCategories[i].weight;
-            }
+    // Distinct skills of a mask, in dictionary order; scores the same as the
+    // extractSkills list of the text the mask was encoded from
+    DynamicArray skillsOfMask(uint64_t mask) const {
+        DynamicArray skills;
+        for (uint64_t bits = mask; bits; bits &= bits - 1) {
+            skills.add(dictionary.skillName(__builtin_ctzll(bits)));
         }
-        return 1.0; // Default weight for unmatched skills
+        return skills;
     }
 
-    DynamicArray extractSkills(const std::string& text) {
-        DynamicArray skills;
-        std::string lowercaseText = toLowercase(text);
+    static bool categoryAllows(CategoryFilterMode mode, uint8_t jobCats, uint8_t resumeCats) {
+        if (mode == CATEGORY_FILTER_OFF || jobCats == 0) return true;
+        if (mode == CATEGORY_FILTER_SOFT) return (jobCats & resumeCats) != 0;
+        return (jobCats & resumeCats) == jobCats;
+    }
 
-        // Regular skill detection
-        for (int i = 0; i < 100; i++) {
-            std::string skill = skillCategories[i].skill;
-            if (lowercaseText.find(skill) != std::string::npos && isValidSkillMatch(lowercaseText, skill)) {
-                skills.add(skill);
-            }
+    struct Match {
+        int resumeIndex;
+        double score;
+    };
+
+    // Stable LSD radix sort by score, descending. Scores are bounded to [0, 100]
+    // and shown with two decimals, so the key is round(score * 100) in 16 bits:
+    // two byte-wide counting passes, O(n) with one scratch buffer.
+    static void radixSortMatches(Match* matches, int count) {
+        if (count < 2) return;
+        uint16_t* keys = new uint16_t[count];
+        uint16_t* keyBuffer = new uint16_t[count];
+        Match* buffer = new Match[count];
+        for (int i = 0; i < count; i++) {
+            double clamped = std::max(0.0, std::min(100.0, matches[i].score));
+            keys[i] = static_cast<uint16_t>(10000 - static_cast<int>(std::lround(clamped * 100.0)));
         }
 
-        // Synonym-based detection
-        for (int i = 0; i < 10; i++) {
-            for (const std::string& variant : skillSynonyms[i].variants) {
-                if (variant.empty()) break;
-                if (lowercaseText.find(variant) != std::string::npos && isValidSkillMatch(lowercaseText, variant)) {
-                    skills.add(skillSynonyms[i].canonical);
-                    break;
-                }
+        for (int shift = 0; shift < 16; shift += 8) {
+            int offsets[257] = {0};
+            for (int i = 0; i < count; i++) offsets[((keys[i] >> shift) & 0xFF) + 1]++;
+            for (int b = 0; b < 256; b++) offsets[b + 1] += offsets[b];
+            for (int i = 0; i < count; i++) {
+                int slot = offsets[(keys[i] >> shift) & 0xFF]++;
+                buffer[slot] = matches[i];
+                keyBuffer[slot] = keys[i];
             }
+            std::memcpy(matches, buffer, sizeof(Match) * count);
+            std::memcpy(keys, keyBuffer, sizeof(uint16_t) * count);
         }
 
-        return skills;
-    }
-
-    bool isValidSkillMatch(const std::string& text, const std::string& skill) {
-        // Prevent partial matches like "ai" in "wait", "hair", "again"
-        std::size_t pos = text.find(skill);
-        
-        if (pos == std::string::npos) return false;
-        
-        // Check character before the match
-        if (pos > 0 && std::isalpha(text[pos - 1])) {
-            return false; // Skill is part of a larger word
-        }
-        
-        // Check character after the match
-        std::size_t after = pos + skill.length();
-        if (after < text.length() && std::isalpha(text[after])) {
-            return false; // Skill is part of a larger word
-        }
-        
-        return true;
+        delete[] keys;
+        delete[] keyBuffer;
+        delete[] buffer;
     }
 
     double calculateWeightedScore(const DynamicArray& jobSkills, const DynamicArray& resumeSkills) {
@@ -258,7 +198,7 @@ private:
 
         // Calculate maximum possible weight based on job requirements
         for (int i = 0; i < jobSkills.getSize(); i++) {
-            maxPossibleWeight += calculateSkillWeight(jobSkills.get(i));
+            maxPossibleWeight += dictionary.calculateSkillWeight(jobSkills.get(i));
         }
 
         if (maxPossibleWeight == 0) {
@@ -272,7 +212,7 @@ private:
             
             for (int j = 0; j < resumeSkills.getSize(); j++) {
                 if (jobSkill == resumeSkills.get(j)) {
-                    totalMatchWeight += calculateSkillWeight(jobSkill);
+                    totalMatchWeight += dictionary.calculateSkillWeight(jobSkill);
                     matchesFound++;
                     found = true;
                     break;
@@ -281,7 +221,7 @@ private:
             
             // Apply penalty for missing important skills
             if (!found) {
-                double skillWeight = calculateSkillWeight(jobSkill);
+                double skillWeight = dictionary.calculateSkillWeight(jobSkill);
                 // Higher penalty for more important missing skills
                 totalMatchWeight -= skillWeight * 0.3; // 30% penalty for missing skills
             }
@@ -308,20 +248,56 @@ private:
         return baseScore;
     }
 
-    std::string toLowercase(const std::string& text) {
-        std::string result = text;
-        for (char& c : result) {
-            c = std::tolower(c);
+    // Drops the '\r' a CRLF file leaves at the end of each line, which text
+    // mode keeps on POSIX and binary mode keeps everywhere
+    static void removeCarriageReturn(std::string& line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
         }
-        return result;
+    }
+
+    // Removes surrounding quotes; true if there were any
+    static bool removeQuotes(std::string& line) {
+        if (line.length() >= 2 && line.front() == '"' && line.back() == '"') {
+            line = line.substr(1, line.length() - 2);
+            return true;
+        }
+        return false;
+    }
+
+    // Calls visit(row) for every data row of an in-memory CSV
+    template <typename Visit>
+    static int forEachBufferRow(const char* data, size_t length, Visit visit) {
+        int rows = 0;
+        bool header = true;
+        size_t start = 0;
+        while (start < length) {
+            const char* newline = static_cast<const char*>(std::memchr(data + start, '\n', length - start));
+            size_t end = newline ? static_cast<size_t>(newline - data) : length;
+            std::string line(data + start, end - start);
+            removeCarriageReturn(line);
+            if (header) {
+                header = false;
+            } else if (!line.empty()) {
+                removeQuotes(line);
+                visit(line);
+                rows++;
+            }
+            start = end + 1;
+        }
+        return rows;
     }
 
 public:
+    JobMatchingSystem() {
+        skillPostings.setIndexedSkills(dictionary.getNamedSkillMask());
+    }
+
     bool loadJobsFromCSV(const std::string& filename) {
         try {
             std::ifstream file(filename);
             if (!file.is_open()) {
-                std::cout << "Error: Cannot open file " << filename << std::endl;
+                if (!quietLoading) std::cout << "Error: Cannot open file " << filename << std::endl;
                 return false;
             }
 
@@ -330,55 +306,99 @@ public:
             std::getline(file, line);
             
             while (std::getline(file, line)) {
+                removeCarriageReturn(line);
                 if (!line.empty()) {
-                    // Remove quotes if present
-                    if (line.front() == '"' && line.back() == '"') {
-                        line = line.substr(1, line.length() - 2);
-                    }
+                    removeQuotes(line);
                     jobDescriptions.add(line);
                 }
             }
             
             file.close();
-            std::cout << "Loaded " << jobDescriptions.getSize() << " job descriptions" << std::endl;
+            if (!quietLoading) std::cout << "Loaded " << jobDescriptions.getSize() << " job descriptions" << std::endl;
             return true;
         } catch (const std::exception& e) {
-            std::cout << "Error loading jobs: " << e.what() << std::endl;
+            if (!quietLoading) std::cout << "Error loading jobs: " << e.what() << std::endl;
             return false;
         }
     }
 
-    bool loadResumesFromCSV(const std::string& filename) {
+    // With shardCount > 1 only rows where (row % shardCount == shardIndex) are kept,
+    // so local resume i is global resume i * shardCount + shardIndex.
+    bool loadResumesFromCSV(const std::string& filename, int shardIndex = 0, int shardCount = 1) {
         try {
-            std::ifstream file(filename);
+            // Binary mode so byte offsets match what LazyTextStore reads back
+            std::ifstream file(filename, std::ios::binary);
             if (!file.is_open()) {
-                std::cout << "Error: Cannot open file " << filename << std::endl;
+                if (!quietLoading) std::cout << "Error: Cannot open file " << filename << std::endl;
                 return false;
             }
+            int source = resumeTexts.addSource(filename);
 
             std::string line;
+            int row = 0;
+            long long offset = 0;
             // Skip header
             std::getline(file, line);
+            offset += line.size() + 1;
             
             while (std::getline(file, line)) {
+                long long lineOffset = offset;
+                offset += line.size() + 1;
+                // Stripped before the quote check, so the stored length covers
+                // only the text LazyTextStore should read back
+                removeCarriageReturn(line);
                 if (!line.empty()) {
-                    // Remove quotes if present
-                    if (line.front() == '"' && line.back() == '"') {
-                        line = line.substr(1, line.length() - 2);
+                    if (row++ % shardCount != shardIndex) {
+                        continue;
+                    }
+                    if (removeQuotes(line)) {
+                        lineOffset++;
                     }
-                    resumeDescriptions.add(line);
+                    uint64_t mask = dictionary.encodeResume(line);
+                    skillPostings.addDocument(resumeSkillMasks.getSize(), mask);
+                    resumeTexts.add(source, lineOffset, line);
+                    resumeSkillMasks.add(mask);
+                    resumeCategoryMasks.add(dictionary.categoriesOf(mask));
                 }
             }
+            skillPostings.optimize();
             
             file.close();
-            std::cout << "Loaded " << resumeDescriptions.getSize() << " resume descriptions" << std::endl;
+            if (!quietLoading) std::cout << "Loaded " << resumeTexts.getSize() << " resume descriptions" << std::endl;
             return true;
         } catch (const std::exception& e) {
-            std::cout << "Error loading resumes: " << e.what() << std::endl;
+            if (!quietLoading) std::cout << "Error loading resumes: " << e.what() << std::endl;
             return false;
         }
     }
 
+    // Adds one job from memory
+    void addJob(const std::string& text) {
+        jobDescriptions.add(text);
+    }
+
+    // Adds one resume from memory; its text stays in memory (no source file)
+    void addResume(const std::string& text) {
+        uint64_t mask = dictionary.encodeResume(text);
+        skillPostings.addDocument(resumeSkillMasks.getSize(), mask);
+        resumeTexts.addInMemory(text);
+        resumeSkillMasks.add(mask);
+        resumeCategoryMasks.add(dictionary.categoriesOf(mask));
+    }
+
+    // Loads jobs or resumes from CSV bytes already in memory, with the same rules
+    // as the file loaders (header skipped, empty rows skipped, quotes removed).
+    // Returns the number of rows added.
+    int loadJobsFromBuffer(const char* data, size_t length) {
+        return forEachBufferRow(data, length, [this](const std::string& row) { addJob(row); });
+    }
+
+    int loadResumesFromBuffer(const char* data, size_t length) {
+        int added = forEachBufferRow(data, length, [this](const std::string& row) { addResume(row); });
+        skillPostings.optimize();
+        return added;
+    }
+
     void findBestMatches(int jobIndex, int topN = 5) {
         if (jobIndex < 0 || jobIndex >= jobDescriptions.getSize()) {
             std::cout << "Error: Invalid job index" << std::endl;
@@ -397,19 +417,22 @@ public:
         std::cout << std::endl;
 
         // Array to store matches
-        struct Match {
-            int resumeIndex;
-            double score;
-        };
-        
-        Match* matches = new Match[resumeDescriptions.getSize()];
+        Match* matches = new Match[resumeTexts.getSize()];
         int matchCount = 0;
 
         clock_t startTime = clock();
         
+        uint8_t jobCats = dictionary.jobCategories(dictionary.encodeJob(jobDescriptions.get(jobIndex)));
+        const uint8_t* resumeCats = resumeCategoryMasks.masks();
+        int skipped = 0;
+
         // Calculate scores for all resumes
-        for (int i = 0; i < resumeDescriptions.getSize(); i++) {
-            DynamicArray resumeSkills = extractSkills(resumeDescriptions.get(i));
+        for (int i = 0; i < resumeTexts.getSize(); i++) {
+            if (!categoryAllows(categoryFilter, jobCats, resumeCats[i])) {
+                skipped++;
+                continue;
+            }
+            DynamicArray resumeSkills = skillsOfMask(resumeSkillMasks.get(i));
             double score = calculateWeightedScore(jobSkills, resumeSkills);
             
             if (score > 0) {
@@ -419,16 +442,9 @@ public:
             }
         }
 
-        // Sort matches using bubble sort (simple array sorting)
-        for (int i = 0; i < matchCount - 1; i++) {
-            for (int j = 0; j < matchCount - i - 1; j++) {
-                if (matches[j].score < matches[j + 1].score) {
-                    Match temp = matches[j];
-                    matches[j] = matches[j + 1];
-                    matches[j + 1] = temp;
-                }
-            }
-        }
+        // Full ranking: matches were collected in index order, and the radix sort
+        // is stable, so this is (score desc, index asc)
+        radixSortMatches(matches, matchCount);
 
         clock_t endTime = clock();
         double duration = double(endTime - startTime) / CLOCKS_PER_SEC;
@@ -443,19 +459,22 @@ public:
                       << " - Score: " << std::fixed << std::setprecision(2) 
                       << matches[i].score << "%" << std::endl;
             std::cout << "   Skills: ";
-            DynamicArray resumeSkills = extractSkills(resumeDescriptions.get(matches[i].resumeIndex));
+            DynamicArray resumeSkills = extractSkills(resumeTexts.get(matches[i].resumeIndex));
             for (int j = 0; j < resumeSkills.getSize(); j++) {
                 std::cout << resumeSkills.get(j);
                 if (j < resumeSkills.getSize() - 1) std::cout << ", ";
             }
             std::cout << "\n   Preview: " 
-                      << resumeDescriptions.get(matches[i].resumeIndex).substr(0, 100) 
+                      << resumeTexts.preview(matches[i].resumeIndex, 100) 
                       << "..." << std::endl << std::endl;
         }
 
         std::cout << "Matching completed in " << duration << " seconds" << std::endl;
-        std::cout << "Total resumes processed: " << resumeDescriptions.getSize() << std::endl;
+        std::cout << "Total resumes processed: " << resumeTexts.getSize() << std::endl;
         std::cout << "Total matches found: " << matchCount << std::endl;
+        if (categoryFilter != CATEGORY_FILTER_OFF) {
+            std::cout << "Skipped by category prefilter: " << skipped << std::endl;
+        }
 
         delete[] matches;
     }
@@ -463,24 +482,33 @@ public:
     void performanceTest() {
         std::cout << "\n=== Performance Test ===" << std::endl;
         
-        if (jobDescriptions.getSize() == 0 || resumeDescriptions.getSize() == 0) {
+        if (jobDescriptions.getSize() == 0 || resumeTexts.getSize() == 0) {
             std::cout << "Error: No data loaded for performance test" << std::endl;
             return;
         }
 
         // Test with first 10 jobs
         int testJobs = std::min(10, jobDescriptions.getSize());
+        int resumeCount = resumeTexts.getSize();
         double totalTime = 0.0;
 
+        // Resume skills do not depend on the job, so they are extracted once
+        clock_t extractStart = clock();
+        DynamicArray* resumeSkills = new DynamicArray[resumeCount];
+        for (int j = 0; j < resumeCount; j++) {
+            resumeSkills[j] = extractSkills(resumeTexts.get(j));
+        }
+        std::cout << "Extracted skills of " << resumeCount << " resumes in "
+                  << double(clock() - extractStart) / CLOCKS_PER_SEC << " seconds" << std::endl;
+
         for (int i = 0; i < testJobs; i++) {
             clock_t startTime = clock();
             
             DynamicArray jobSkills = extractSkills(jobDescriptions.get(i));
             int matchCount = 0;
             
-            for (int j = 0; j < resumeDescriptions.getSize(); j++) {
-                DynamicArray resumeSkills = extractSkills(resumeDescriptions.get(j));
-                double score = calculateWeightedScore(jobSkills, resumeSkills);
+            for (int j = 0; j < resumeCount; j++) {
+                double score = calculateWeightedScore(jobSkills, resumeSkills[j]);
                 if (score > 50.0) { // Count matches above 50%
                     matchCount++;
                 }
@@ -496,8 +524,712 @@ public:
 
         std::cout << "\nAverage matching time per job: " << totalTime / testJobs << " seconds" << std::endl;
         std::cout << "Total memory used: ~" 
-                  << (jobDescriptions.getSize() + resumeDescriptions.getSize()) * 1000 / 1024 
+                  << (jobDescriptions.getSize() + resumeTexts.getSize()) * 1000 / 1024 
                   << " KB (estimated)" << std::endl;
+
+        batchScorerTest(testJobs, resumeSkills);
+        delete[] resumeSkills;
+        sharedScanTest(testJobs);
+        rankingSortTest();
+        postingSetTest();
+    }
+
+    // AND / OR of skill postings: the compressed bitmaps against the same
+    // postings as plain sorted int lists, the layout they replaced. Every pair
+    // of the busiest skills is intersected and united with both.
+    void postingSetTest() const {
+        const int maxSkills = 8;
+        const int rounds = 20;
+
+        // The indexed skills with the most postings, busiest first
+        int skills[maxSkills];
+        int skillCount = 0;
+        uint64_t remaining = skillPostings.getIndexedSkills();
+        while (skillCount < maxSkills) {
+            int busiest = -1;
+            for (uint64_t bits = remaining; bits; bits &= bits - 1) {
+                int id = __builtin_ctzll(bits);
+                if (busiest < 0 || skillPostings.get(id).cardinality() > skillPostings.get(busiest).cardinality()) {
+                    busiest = id;
+                }
+            }
+            if (busiest < 0 || skillPostings.get(busiest).isEmpty()) {
+                break;
+            }
+            skills[skillCount++] = busiest;
+            remaining &= ~(1ull << busiest);
+        }
+        if (skillCount < 2) {
+            return;
+        }
+
+        PostingList plain[maxSkills];
+        for (int i = 0; i < skillCount; i++) {
+            skillPostings.get(skills[i]).forEach([&](uint32_t document) { plain[i].add(static_cast<int>(document)); });
+        }
+
+        long long bitmapAnd = 0, bitmapOr = 0, plainAnd = 0, plainOr = 0;
+        clock_t start = clock();
+        for (int r = 0; r < rounds; r++) {
+            for (int a = 0; a < skillCount; a++) {
+                for (int b = a + 1; b < skillCount; b++) {
+                    bitmapAnd += RoaringBitmap::intersect(skillPostings.get(skills[a]), skillPostings.get(skills[b])).cardinality();
+                }
+            }
+        }
+        double bitmapAndTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int r = 0; r < rounds; r++) {
+            for (int a = 0; a < skillCount; a++) {
+                for (int b = a + 1; b < skillCount; b++) {
+                    bitmapOr += RoaringBitmap::unite(skillPostings.get(skills[a]), skillPostings.get(skills[b])).cardinality();
+                }
+            }
+        }
+        double bitmapOrTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+        PostingList result;
+        start = clock();
+        for (int r = 0; r < rounds; r++) {
+            for (int a = 0; a < skillCount; a++) {
+                for (int b = a + 1; b < skillCount; b++) {
+                    PostingList::intersect(plain[a], plain[b], result);
+                    plainAnd += result.getSize();
+                }
+            }
+        }
+        double plainAndTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int r = 0; r < rounds; r++) {
+            for (int a = 0; a < skillCount; a++) {
+                for (int b = a + 1; b < skillCount; b++) {
+                    PostingList::unite(plain[a], plain[b], result);
+                    plainOr += result.getSize();
+                }
+            }
+        }
+        double plainOrTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+        int pairs = skillCount * (skillCount - 1) / 2 * rounds;
+        std::cout << "\n=== Skill Set Operations (" << pairs << " pairs of the " << skillCount
+                  << " busiest skills) ===" << std::endl;
+        std::cout << std::setprecision(2)
+                  << "AND: bitmaps " << bitmapAndTime * 1e6 / pairs << " us | int lists "
+                  << plainAndTime * 1e6 / pairs << " us per pair" << std::endl;
+        std::cout << "OR:  bitmaps " << bitmapOrTime * 1e6 / pairs << " us | int lists "
+                  << plainOrTime * 1e6 / pairs << " us per pair" << std::endl;
+        std::cout << "Same results: " << (bitmapAnd == plainAnd && bitmapOr == plainOr ? "yes" : "NO") << std::endl;
+    }
+
+    // Full-ranking export size: sorts 1,000,000 scored entries (the job 1 scores
+    // repeated) with the radix sort and checks the (score desc, index asc) order
+    void rankingSortTest() {
+        const int total = 1000000;
+        int resumeCount = resumeSkillMasks.getSize();
+        float* scores = new float[resumeCount];
+        EncodedJob job = dictionary.encodeJob(jobDescriptions.get(0));
+        BatchScorer::scoreBlock(job, resumeSkillMasks.lowWords(), resumeSkillMasks.highWords(), resumeCount, scores);
+
+        Match* matches = new Match[total];
+        for (int i = 0; i < total; i++) {
+            matches[i].resumeIndex = i;
+            matches[i].score = scores[i % resumeCount];
+        }
+
+        clock_t startTime = clock();
+        radixSortMatches(matches, total);
+        double duration = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+        bool ordered = true;
+        for (int i = 1; i < total && ordered; i++) {
+            long previousKey = std::lround(matches[i - 1].score * 100.0);
+            long key = std::lround(matches[i].score * 100.0);
+            ordered = previousKey > key || (previousKey == key && matches[i - 1].resumeIndex < matches[i].resumeIndex);
+        }
+
+        std::cout << "\n=== Full Ranking Sort ===" << std::endl;
+        std::cout << "Radix sort of " << total << " matches: " << std::setprecision(5) << duration
+                  << " seconds | Order (score desc, index asc): " << (ordered ? "ok" : "BROKEN") << std::endl;
+
+        delete[] matches;
+        delete[] scores;
+    }
+
+    // Compares one scan per job against one shared scan for the whole batch
+    void sharedScanTest(int testJobs) {
+        const int topN = 5;
+        std::cout << "\n=== Shared Scan (" << testJobs << " jobs, top " << topN << ") ===" << std::endl;
+
+        int* jobIndices = new int[testJobs];
+        for (int i = 0; i < testJobs; i++) jobIndices[i] = i;
+        ScoredIndex* separate = new ScoredIndex[testJobs * topN];
+        ScoredIndex* shared = new ScoredIndex[testJobs * topN];
+        int* separateCounts = new int[testJobs];
+        int* sharedCounts = new int[testJobs];
+
+        const int rounds = 20;
+        clock_t startTime = clock();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < testJobs; i++) {
+                separateCounts[i] = topMatchesForJobText(jobDescriptions.get(i), topN, separate + i * topN);
+            }
+        }
+        double separateTime = double(clock() - startTime) / CLOCKS_PER_SEC / rounds;
+
+        startTime = clock();
+        for (int r = 0; r < rounds; r++) {
+            findBestMatchesBatch(jobIndices, testJobs, topN, shared, sharedCounts);
+        }
+        double sharedTime = double(clock() - startTime) / CLOCKS_PER_SEC / rounds;
+
+        bool same = true;
+        for (int i = 0; i < testJobs && same; i++) {
+            same = separateCounts[i] == sharedCounts[i];
+            for (int j = 0; same && j < sharedCounts[i]; j++) {
+                same = separate[i * topN + j].index == shared[i * topN + j].index;
+            }
+        }
+
+        std::cout << "One scan per job: " << std::setprecision(5) << separateTime << " seconds per batch" << std::endl;
+        std::cout << "Shared scan:      " << sharedTime << " seconds per batch" << std::endl;
+        std::cout << "Resume data streamed: " << testJobs << "x vs 1x | Same rankings: "
+                  << (same ? "yes" : "NO") << std::endl;
+
+        delete[] jobIndices;
+        delete[] separate;
+        delete[] shared;
+        delete[] separateCounts;
+        delete[] sharedCounts;
+    }
+
+    EncodedJob encodeJobText(const std::string& jobText) {
+        return dictionary.encodeJob(jobText);
+    }
+
+    uint64_t encodeResumeText(const std::string& resumeText) {
+        return dictionary.encodeResume(resumeText);
+    }
+
+    // Multi-query shared scan: walks the resume masks once in cache-sized blocks
+    // and scores each block against every job before moving on, so the corpus is
+    // streamed from memory once per batch instead of once per job. Positive scores
+    // go into heaps[i] for jobs[i]; heaps may have different capacities.
+    //
+    // With a category prefilter active, each block is first compacted to the
+    // resumes whose category byte passes, and only those are scored.
+    void scanTopMatches(const EncodedJob* jobs, int jobCount, TopKHeap** heaps) const {
+        const int blockSize = 4096;   // 32 KB of masks: stays in L1/L2 across the batch
+        const uint32_t* lo = resumeSkillMasks.lowWords();
+        const uint32_t* hi = resumeSkillMasks.highWords();
+        const uint8_t* categories = resumeCategoryMasks.masks();
+
+        for (int start = 0; start < resumeSkillMasks.getSize(); start += blockSize) {
+            int count = std::min(blockSize, resumeSkillMasks.getSize() - start);
+            scoreBlockForJobs(lo + start, hi + start, categories + start, start, count, jobs, jobCount, heaps);
+        }
+    }
+
+    // Scores one block of at most 4096 resumes (numbered from `start`) against
+    // every job and offers the positive scores to the job's heap
+    void scoreBlockForJobs(const uint32_t* lo, const uint32_t* hi, const uint8_t* categories,
+                           int start, int count, const EncodedJob* jobs, int jobCount,
+                           TopKHeap** heaps) const {
+        const int blockSize = 4096;
+        float scores[blockSize];
+        int kept[blockSize];
+        uint32_t keptLo[blockSize];
+        uint32_t keptHi[blockSize];
+
+        for (int j = 0; j < jobCount; j++) {
+            if (jobs[j].totalCount == 0) continue;
+            TopKHeap& heap = *heaps[j];
+            uint8_t jobCats = dictionary.jobCategories(jobs[j]);
+
+            if (categoryFilter == CATEGORY_FILTER_OFF || jobCats == 0) {
+                BatchScorer::scoreBlock(jobs[j], lo, hi, count, scores);
+                for (int i = 0; i < count; i++) {
+                    if (scores[i] > 0) {
+                        heap.offer(start + i, scores[i]);
+                    }
+                }
+                continue;
+            }
+
+            int keptCount = 0;
+            for (int i = 0; i < count; i++) {
+                if (categoryAllows(categoryFilter, jobCats, categories[i])) {
+                    kept[keptCount] = start + i;
+                    keptLo[keptCount] = lo[i];
+                    keptHi[keptCount] = hi[i];
+                    keptCount++;
+                }
+            }
+            BatchScorer::scoreBlock(jobs[j], keptLo, keptHi, keptCount, scores);
+            for (int i = 0; i < keptCount; i++) {
+                if (scores[i] > 0) {
+                    heap.offer(kept[i], scores[i]);
+                }
+            }
+        }
+    }
+
+    // Streaming mode for resume files larger than memory: reads `filename` in
+    // fixed-size byte chunks, encodes the rows into one block of masks at a time
+    // and scores each full block against every job. Memory stays at the read
+    // buffer, one block and the per-job heaps, whatever the file size. Rows are
+    // numbered the way loadResumesFromCSV numbers them, so results line up with
+    // the in-memory scan. Returns the number of resumes read, or -1 on error.
+    long long streamTopMatches(const std::string& filename, const EncodedJob* jobs, int jobCount,
+                               TopKHeap** heaps, int chunkBytes = 1 << 20) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cout << "Error: Cannot open file " << filename << std::endl;
+            return -1;
+        }
+
+        const int blockSize = 4096;
+        uint32_t blockLo[blockSize];
+        uint32_t blockHi[blockSize];
+        uint8_t blockCategories[blockSize];
+        int blockCount = 0;
+        long long blockStart = 0;
+        bool headerSkipped = false;
+        bool tooLarge = false;
+        std::string line;   // row being assembled; may span chunk boundaries
+
+        auto flushBlock = [&]() {
+            scoreBlockForJobs(blockLo, blockHi, blockCategories, static_cast<int>(blockStart),
+                              blockCount, jobs, jobCount, heaps);
+            blockStart += blockCount;
+            blockCount = 0;
+        };
+        auto takeRow = [&]() {
+            removeCarriageReturn(line);
+            if (!headerSkipped) {
+                headerSkipped = true;
+                return;
+            }
+            if (line.empty()) return;
+            if (blockStart + blockCount >= std::numeric_limits<int>::max()) {
+                tooLarge = true;
+                return;
+            }
+            removeQuotes(line);
+            uint64_t mask = dictionary.encodeResume(line);
+            blockLo[blockCount] = static_cast<uint32_t>(mask);
+            blockHi[blockCount] = static_cast<uint32_t>(mask >> 32);
+            blockCategories[blockCount] = dictionary.categoriesOf(mask);
+            if (++blockCount == blockSize) {
+                flushBlock();
+            }
+        };
+
+        int readSize = chunkBytes > 0 ? chunkBytes : 1;
+        char* buffer = new char[readSize];
+        while (!tooLarge) {
+            file.read(buffer, readSize);
+            if (file.gcount() <= 0) break;
+            const char* position = buffer;
+            const char* end = buffer + file.gcount();
+            while (position < end) {
+                const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+                if (newline == NULL) {
+                    line.append(position, end);
+                    break;
+                }
+                line.append(position, newline);
+                takeRow();
+                line.clear();
+                position = newline + 1;
+            }
+        }
+        if (!line.empty()) {
+            takeRow();
+        }
+        if (blockCount > 0) {
+            flushBlock();
+        }
+        delete[] buffer;
+
+        if (tooLarge) {
+            std::cout << "Error: resume file has more rows than a resume index can address" << std::endl;
+            return -1;
+        }
+        return blockStart;
+    }
+
+    // Best `k` resumes for each of `jobCount` loaded jobs in one pass. Results for
+    // job i go to results[i * k ...] in ranking order, their number to resultCounts[i].
+    void findBestMatchesBatch(const int* jobIndices, int jobCount, int k,
+                              ScoredIndex* results, int* resultCounts) {
+        EncodedJob* jobs = new EncodedJob[jobCount];
+        TopKHeap** heaps = new TopKHeap*[jobCount];
+        for (int j = 0; j < jobCount; j++) {
+            if (jobIndices[j] < 0 || jobIndices[j] >= jobDescriptions.getSize()) {
+                delete[] jobs;
+                for (int h = 0; h < j; h++) delete heaps[h];
+                delete[] heaps;
+                throw std::out_of_range("Invalid job index");
+            }
+            jobs[j] = dictionary.encodeJob(jobDescriptions.get(jobIndices[j]));
+            heaps[j] = new TopKHeap(k);
+        }
+
+        scanTopMatches(jobs, jobCount, heaps);
+
+        for (int j = 0; j < jobCount; j++) {
+            resultCounts[j] = heaps[j]->sorted(results + j * k);
+            delete heaps[j];
+        }
+        delete[] heaps;
+        delete[] jobs;
+    }
+
+    // findBestMatchesBatch over a resume file that is never loaded into memory.
+    // Returns the number of resumes streamed, or -1 on error.
+    long long findBestMatchesStreaming(const std::string& filename, const int* jobIndices, int jobCount,
+                                       int k, ScoredIndex* results, int* resultCounts) {
+        EncodedJob* jobs = new EncodedJob[jobCount];
+        TopKHeap** heaps = new TopKHeap*[jobCount];
+        for (int j = 0; j < jobCount; j++) {
+            if (jobIndices[j] < 0 || jobIndices[j] >= jobDescriptions.getSize()) {
+                delete[] jobs;
+                for (int h = 0; h < j; h++) delete heaps[h];
+                delete[] heaps;
+                throw std::out_of_range("Invalid job index");
+            }
+            jobs[j] = dictionary.encodeJob(jobDescriptions.get(jobIndices[j]));
+            heaps[j] = new TopKHeap(k);
+        }
+
+        long long rows = streamTopMatches(filename, jobs, jobCount, heaps);
+
+        for (int j = 0; j < jobCount; j++) {
+            resultCounts[j] = rows >= 0 ? heaps[j]->sorted(results + j * k) : 0;
+            delete heaps[j];
+        }
+        delete[] heaps;
+        delete[] jobs;
+        return rows;
+    }
+
+    // Near-miss query: every resume that lacks at most `maxMissing` of the job's
+    // distinct required skills goes into `heap`, ranked by the weighted score.
+    // Returns how many resumes qualify.
+    //
+    // A qualifying resume must contain at least one of any maxMissing + 1 required
+    // skills, so only the postings of the maxMissing + 1 rarest skills are walked;
+    // each candidate is then checked with one popcount on its skill mask.
+    int nearMissCandidates(const EncodedJob& job, int maxMissing, TopKHeap& heap) const {
+        if (maxMissing < 0) {
+            return 0;
+        }
+
+        uint64_t required = job.skillMask & dictionary.getNamedSkillMask();
+        int requiredCount = __builtin_popcountll(required);
+        const uint32_t* lo = resumeSkillMasks.lowWords();
+        const uint32_t* hi = resumeSkillMasks.highWords();
+        int resumeCount = resumeSkillMasks.getSize();
+
+        if (maxMissing >= requiredCount) {
+            // Nothing can be excluded: every resume qualifies
+            scoreAllDocuments(job, heap);
+            return resumeCount;
+        }
+
+        // Pick the maxMissing + 1 required skills with the shortest postings
+        int chosen[MAX_ENCODED_SKILLS];
+        int chosenCount = 0;
+        long long bound = 0;
+        uint64_t remaining = required;
+        while (chosenCount <= maxMissing) {
+            int rarest = -1;
+            for (uint64_t bits = remaining; bits; bits &= bits - 1) {
+                int id = __builtin_ctzll(bits);
+                if (rarest < 0 || skillPostings.get(id).cardinality() < skillPostings.get(rarest).cardinality()) {
+                    rarest = id;
+                }
+            }
+            chosen[chosenCount++] = rarest;
+            bound += skillPostings.get(rarest).cardinality();
+            remaining &= ~(1ull << rarest);
+        }
+
+        // A document seen in an earlier list contains that list's skill, which
+        // makes the union duplicate-free; the scratch array is in list order,
+        // not sorted, which the heap does not need
+        int* qualifying = new int[bound > 0 ? bound : 1];
+        int qualifyingCount = 0;
+        uint64_t earlier = 0;
+        for (int c = 0; c < chosenCount; c++) {
+            skillPostings.get(chosen[c]).forEach([&](uint32_t document) {
+                uint64_t mask = (static_cast<uint64_t>(hi[document]) << 32) | lo[document];
+                if (!(mask & earlier) && __builtin_popcountll(required & ~mask) <= maxMissing) {
+                    qualifying[qualifyingCount++] = static_cast<int>(document);
+                }
+            });
+            earlier |= 1ull << chosen[c];
+        }
+
+        scoreDocuments(job, qualifying, qualifyingCount, false, heap);
+        delete[] qualifying;
+        return qualifyingCount;
+    }
+
+    // Scores every resume in index order, straight from the mask arrays, and
+    // offers them all to `heap`
+    void scoreAllDocuments(const EncodedJob& job, TopKHeap& heap) const {
+        const int blockSize = 4096;
+        float scores[blockSize];
+        const uint32_t* lo = resumeSkillMasks.lowWords();
+        const uint32_t* hi = resumeSkillMasks.highWords();
+        int resumeCount = resumeSkillMasks.getSize();
+
+        for (int start = 0; start < resumeCount; start += blockSize) {
+            int blockCount = std::min(blockSize, resumeCount - start);
+            BatchScorer::scoreBlock(job, lo + start, hi + start, blockCount, scores);
+            for (int i = 0; i < blockCount; i++) {
+                heap.offer(start + i, scores[i]);
+            }
+        }
+    }
+
+    // Scores a list of resumes with the batch kernel (gathering their masks into
+    // contiguous blocks first) and offers them to `heap`
+    void scoreDocuments(const EncodedJob& job, const int* documents, int count,
+                        bool positiveOnly, TopKHeap& heap) const {
+        const int blockSize = 4096;
+        uint32_t blockLo[blockSize];
+        uint32_t blockHi[blockSize];
+        float scores[blockSize];
+        const uint32_t* lo = resumeSkillMasks.lowWords();
+        const uint32_t* hi = resumeSkillMasks.highWords();
+
+        for (int start = 0; start < count; start += blockSize) {
+            int blockCount = std::min(blockSize, count - start);
+            for (int i = 0; i < blockCount; i++) {
+                blockLo[i] = lo[documents[start + i]];
+                blockHi[i] = hi[documents[start + i]];
+            }
+            BatchScorer::scoreBlock(job, blockLo, blockHi, blockCount, scores);
+            for (int i = 0; i < blockCount; i++) {
+                if (!positiveOnly || scores[i] > 0) {
+                    heap.offer(documents[start + i], scores[i]);
+                }
+            }
+        }
+    }
+
+    // Resumes passing a boolean skill filter, in increasing index order.
+    // Throws std::invalid_argument for syntax errors or unknown names.
+    DocSet filterResumes(const std::string& expression) const {
+        SkillFilterParser parser;
+        FilterNode* root = parser.parse(expression);
+        auto resolve = [this](const std::string& term) { return dictionary.resolveFilterTerm(term); };
+        SkillFilterEvaluator<decltype(resolve)> evaluator(skillPostings, resumeSkillMasks.getSize(), resolve);
+        try {
+            DocSet result = evaluator.run(root);
+            delete root;
+            return result;
+        } catch (...) {
+            delete root;
+            throw;
+        }
+    }
+
+    // findBestMatches restricted to resumes that pass `expression`; only those are scored
+    void findBestMatchesFiltered(int jobIndex, const std::string& expression, int topN = 5) {
+        if (jobIndex < 0 || jobIndex >= jobDescriptions.getSize()) {
+            std::cout << "Error: Invalid job index" << std::endl;
+            return;
+        }
+
+        clock_t startTime = clock();
+        DocSet passing;
+        try {
+            passing = filterResumes(expression);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            return;
+        }
+        double filterTime = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+        int passingCount = static_cast<int>(passing.size());
+        int* documents = new int[passingCount > 0 ? passingCount : 1];
+        passing.bitmap().toArray(documents);
+
+        EncodedJob job = dictionary.encodeJob(jobDescriptions.get(jobIndex));
+        TopKHeap heap(topN);
+        scoreDocuments(job, documents, passingCount, true, heap);
+        delete[] documents;
+        double totalTime = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+        std::cout << "\n=== Filtered Matches for Job " << jobIndex + 1 << " ===" << std::endl;
+        std::cout << "Filter: " << expression << std::endl;
+        std::cout << "Required Skills: " << describeSkills(job.skillMask) << std::endl;
+
+        ScoredIndex* best = new ScoredIndex[topN > 0 ? topN : 1];
+        int shown = heap.sorted(best);
+        for (int i = 0; i < shown; i++) {
+            std::cout << i + 1 << ". Resume " << best[i].index + 1
+                      << " - Score: " << std::fixed << std::setprecision(2) << best[i].score << "%" << std::endl;
+            std::cout << "   Skills: " << describeSkills(resumeSkillMasks.get(best[i].index)) << std::endl;
+        }
+        delete[] best;
+
+        std::cout << "Resumes passing filter: " << passingCount << " of " << resumeSkillMasks.getSize() << std::endl;
+        std::cout << "Filter time: " << std::fixed << std::setprecision(5) << filterTime
+                  << " seconds | Total: " << totalTime << " seconds" << std::endl;
+    }
+
+    // Recruiter view: resumes missing at most `maxMissing` required skills
+    void findNearMissMatches(int jobIndex, int maxMissing, int topN = 10) {
+        if (jobIndex < 0 || jobIndex >= jobDescriptions.getSize()) {
+            std::cout << "Error: Invalid job index" << std::endl;
+            return;
+        }
+
+        EncodedJob job = dictionary.encodeJob(jobDescriptions.get(jobIndex));
+        uint64_t required = job.skillMask & dictionary.getNamedSkillMask();
+
+        std::cout << "\n=== Candidates Missing At Most " << maxMissing << " Skills for Job "
+                  << jobIndex + 1 << " ===" << std::endl;
+        std::cout << "Required Skills: " << describeSkills(required) << std::endl;
+
+        clock_t startTime = clock();
+        TopKHeap heap(topN);
+        int found = nearMissCandidates(job, maxMissing, heap);
+        double duration = double(clock() - startTime) / CLOCKS_PER_SEC;
+
+        ScoredIndex* best = new ScoredIndex[topN > 0 ? topN : 1];
+        int shown = heap.sorted(best);
+        for (int i = 0; i < shown; i++) {
+            uint64_t missing = required & ~resumeSkillMasks.get(best[i].index);
+            std::cout << i + 1 << ". Resume " << best[i].index + 1
+                      << " - Score: " << std::fixed << std::setprecision(2) << best[i].score << "%"
+                      << " | Missing: " << (missing ? describeSkills(missing) : "none") << std::endl;
+        }
+        delete[] best;
+
+        std::cout << "Qualifying resumes: " << found << " of " << resumeSkillMasks.getSize() << std::endl;
+        std::cout << "Query completed in " << std::setprecision(4) << duration << " seconds" << std::endl;
+    }
+
+    // Comma separated names of the named skills of a skill mask, in dictionary order
+    std::string describeSkills(uint64_t mask) const {
+        std::string text;
+        for (uint64_t bits = mask & dictionary.getNamedSkillMask(); bits; bits &= bits - 1) {
+            if (!text.empty()) text += ", ";
+            text += dictionary.skillName(__builtin_ctzll(bits));
+        }
+        return text;
+    }
+
+    // Best `k` resumes with a positive score for an arbitrary job text, written to
+    // `out` in ranking order. Returns the number of entries written.
+    int topMatchesForJobText(const std::string& jobText, int k, ScoredIndex* out) {
+        EncodedJob job = dictionary.encodeJob(jobText);
+        TopKHeap heap(k);
+        TopKHeap* heaps[1] = {&heap};
+        scanTopMatches(&job, 1, heaps);
+        return heap.sorted(out);
+    }
+
+    // Scores every loaded resume against one job with the CPU's widest kernel.
+    // `scores` must hold getResumeCount() entries.
+    void scoreResumesBatch(int jobIndex, float* scores) {
+        if (jobIndex < 0 || jobIndex >= jobDescriptions.getSize()) {
+            throw std::out_of_range("Invalid job index");
+        }
+        EncodedJob job = dictionary.encodeJob(jobDescriptions.get(jobIndex));
+        BatchScorer::scoreBlock(job, resumeSkillMasks.lowWords(), resumeSkillMasks.highWords(),
+                                resumeSkillMasks.getSize(), scores);
+    }
+
+    // Validates the batch kernels against calculateWeightedScore and reports
+    // throughput. `resumeSkills` holds the extracted skills of every resume.
+    void batchScorerTest(int testJobs, const DynamicArray* resumeSkills) {
+        int resumeCount = resumeSkillMasks.getSize();
+        const BatchScorer::ScoreKernel& fast = BatchScorer::selectedKernel();
+        const BatchScorer::ScoreKernel& scalar = BatchScorer::scalarKernel();
+
+        std::cout << "\n=== Batch Scorer (" << fast.name << " kernel) ===" << std::endl;
+
+        float* fastScores = new float[resumeCount];
+        float* scalarScores = new float[resumeCount];
+        const uint32_t* lo = resumeSkillMasks.lowWords();
+        const uint32_t* hi = resumeSkillMasks.highWords();
+
+        // Encoded up front so the timed loop below measures the kernels alone
+        EncodedJob* jobs = new EncodedJob[testJobs];
+        for (int i = 0; i < testJobs; i++) {
+            jobs[i] = dictionary.encodeJob(jobDescriptions.get(i));
+        }
+
+        // Validation against the reference scorer
+        int mismatches = 0;
+        double maxError = 0.0;
+        for (int i = 0; i < testJobs; i++) {
+            DynamicArray jobSkills = extractSkills(jobDescriptions.get(i));
+            fast.score(jobs[i], lo, hi, resumeCount, fastScores);
+            scalar.score(jobs[i], lo, hi, resumeCount, scalarScores);
+
+            for (int j = 0; j < resumeCount; j++) {
+                double expected = calculateWeightedScore(jobSkills, resumeSkills[j]);
+                double error = std::max(std::fabs(fastScores[j] - expected), std::fabs(scalarScores[j] - expected));
+                maxError = std::max(maxError, error);
+                if (error > 1e-3) {
+                    mismatches++;
+                }
+            }
+        }
+        std::cout << "Validated " << testJobs * resumeCount << " pairs: " << mismatches
+                  << " mismatches (max error " << std::scientific << std::setprecision(2)
+                  << maxError << std::fixed << ")" << std::endl;
+
+        // Throughput: repeat the full scan until enough pairs have been scored
+        const BatchScorer::ScoreKernel* kernels[2] = {&scalar, &fast};
+        for (int k = 0; k < 2; k++) {
+            long long pairs = 0;
+            float checksum = 0.0f;
+            clock_t startTime = clock();
+            while (pairs < 200000000LL && resumeCount > 0) {
+                for (int i = 0; i < testJobs; i++) {
+                    kernels[k]->score(jobs[i], lo, hi, resumeCount, fastScores);
+                    checksum += fastScores[i % resumeCount];
+                    pairs += resumeCount;
+                }
+                if (double(clock() - startTime) / CLOCKS_PER_SEC > 1.0) break;
+            }
+            double duration = double(clock() - startTime) / CLOCKS_PER_SEC;
+            std::cout << std::setw(7) << kernels[k]->name << ": " << pairs << " pairs in "
+                      << std::setprecision(3) << duration << " s ("
+                      << std::setprecision(1) << (duration > 0 ? pairs / duration / 1e6 : 0.0)
+                      << " M pairs/s, checksum " << checksum << ")" << std::endl;
+        }
+
+        delete[] jobs;
+        delete[] fastScores;
+        delete[] scalarScores;
+    }
+
+    // Silences the CSV loaders, for processes whose stdout is not the user's
+    void setQuietLoading(bool quiet) {
+        quietLoading = quiet;
+    }
+
+    void setCategoryFilter(CategoryFilterMode mode) {
+        categoryFilter = mode;
+    }
+
+    CategoryFilterMode getCategoryFilter() const {
+        return categoryFilter;
+    }
+
+    const std::string& getJobDescription(int index) const {
+        return jobDescriptions.get(index);
     }
 
     int getJobCount() const {
@@ -505,7 +1237,24 @@ public:
     }
 
     int getResumeCount() const {
-        return resumeDescriptions.getSize();
+        return resumeTexts.getSize();
+    }
+
+    // Skill index footprint: compressed bitmaps vs plain sorted int postings
+    void displayIndexStats() const {
+        long long postings = skillPostings.getPostingCount();
+        long long bytes = skillPostings.getMemoryBytes();
+        long long plainBytes = postings * static_cast<long long>(sizeof(int));
+        std::cout << "Skill index: " << postings << " postings | "
+                  << std::fixed << std::setprecision(1) << bytes / 1024.0 << " KB compressed vs "
+                  << plainBytes / 1024.0 << " KB as int lists";
+        if (bytes > 0) {
+            std::cout << " (" << std::setprecision(2) << double(plainBytes) / bytes << "x smaller)";
+        }
+        std::cout << std::endl;
+        std::cout << "Resume text: " << std::setprecision(1) << resumeTexts.memoryBytes() / 1024.0
+                  << " KB resident (previews + offsets) for " << resumeTexts.textBytes() / 1024.0
+                  << " KB of text kept on disk" << std::endl;
     }
 };
 
@@ -5,27 +5,20 @@
 #include <string>
 #include <ctime>
 #include <algorithm>
+#include <functional>
+#include "MatchingEngine.h"
 using namespace std;
 
-// single linked list node for jobs
+// job record, stored in a JobLinkedList
 struct JobNode {
     string jobId;
     string jobDescription;
-    JobNode* next;
 };
 
-// single linked list node for resumes
+// resume record, stored in a ResumeLinkedList
 struct ResumeNode {
     string resumeId;
     string resumeDescription;
-    ResumeNode* next;
-};
-
-// single linked list node for skillweight pairs
-struct SkillWeightNode {
-    string skill;
-    double weight;
-    SkillWeightNode* next;
 };
 
 // single linked list node for a scored result
@@ -35,92 +28,208 @@ struct TopMatchNode {
     TopMatchNode* next;
 };
 
-// simple list for skills
-class SkillWeightLinkedList {
-public:
-    SkillWeightNode* head = NULL;
-    void insertSkill(string skill, double weight) {
-        SkillWeightNode* n = new SkillWeightNode{skill, weight, NULL};
-        if (!head) head = n;
-        else {
-            SkillWeightNode* t = head;
-            while (t->next) t = t->next;
-            t->next = n;
-        }
-    }
-};
+// classic singly linked list, one record per node
+template <typename T>
+class SinglyLinkedList {
+    struct Node { T data; Node* next; };
+    Node* head = NULL;
+    Node* tail = NULL;
 
-// simple lists for jobs and resumes
-class JobLinkedList {
 public:
-    JobNode* head = NULL;
-    JobNode* tail = NULL;
     int size = 0;
+
+    class iterator {
+        Node* n;
+    public:
+        explicit iterator(Node* p) : n(p) {}
+        T& operator*() const { return n->data; }
+        T* operator->() const { return &n->data; }
+        iterator& operator++() { n = n->next; return *this; }
+        bool operator!=(const iterator& o) const { return n != o.n; }
+    };
+
+    SinglyLinkedList() {}
+    SinglyLinkedList(const SinglyLinkedList&) = delete;
+    SinglyLinkedList& operator=(const SinglyLinkedList&) = delete;
+    ~SinglyLinkedList() {
+        while (head) { Node* d = head; head = head->next; delete d; }
+    }
+
+    // returns the stored record, its address never changes
+    T& append(T value) {
+        Node* n = new Node{std::move(value), NULL};
+        if (!head) head = tail = n;
+        else { tail->next = n; tail = n; }
+        size++;
+        return n->data;
+    }
+
+    iterator begin() const { return iterator(head); }
+    iterator end() const { return iterator(NULL); }
+    static string layout() { return "classic (1 record per node)"; }
 };
 
-class ResumeLinkedList {
+// unrolled linked list: every node holds up to CAP records in a fixed array,
+// so a scan follows one pointer per CAP records and reads contiguous memory
+// in between. records are never moved once appended
+template <typename T, int CAP>
+class UnrolledLinkedList {
+    struct Block { T items[CAP]; int count; Block* next; };
+    Block* head = NULL;
+    Block* tail = NULL;
+
 public:
-    ResumeNode* head = NULL;
-    ResumeNode* tail = NULL;
     int size = 0;
+
+    class iterator {
+        Block* b;
+        int i;
+    public:
+        iterator(Block* p, int slot) : b(p), i(slot) {}
+        T& operator*() const { return b->items[i]; }
+        T* operator->() const { return &b->items[i]; }
+        iterator& operator++() {
+            if (++i == b->count) { b = b->next; i = 0; }
+            return *this;
+        }
+        bool operator!=(const iterator& o) const { return b != o.b || i != o.i; }
+    };
+
+    UnrolledLinkedList() {}
+    UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+    ~UnrolledLinkedList() {
+        while (head) { Block* d = head; head = head->next; delete d; }
+    }
+
+    T& append(T value) {
+        if (!tail || tail->count == CAP) {
+            Block* n = new Block();
+            if (!head) head = tail = n;
+            else { tail->next = n; tail = n; }
+        }
+        T& slot = tail->items[tail->count++];
+        slot = std::move(value);
+        size++;
+        return slot;
+    }
+
+    iterator begin() const { return iterator(head, 0); }
+    iterator end() const { return iterator(NULL, 0); }
+    static string layout() { return "unrolled (" + to_string(CAP) + " records per node)"; }
 };
 
-// a bunch of skills set with score
-void initializeSkillWeights(SkillWeightLinkedList& w) {
-    w.insertSkill("data", 10);      w.insertSkill("sql", 10);
-    w.insertSkill("agile", 9);      w.insertSkill("learning", 9);
-    w.insertSkill("product", 9);    w.insertSkill("python", 9);
-    w.insertSkill("engineer", 8);   w.insertSkill("management", 8);
-    w.insertSkill("power", 8);      w.insertSkill("machine", 8);
-    w.insertSkill("stories", 7);    w.insertSkill("user", 7);
-    w.insertSkill("stakeholder", 7);w.insertSkill("scrum", 7);
-    w.insertSkill("roadmap", 7);    w.insertSkill("deep", 7);
-    w.insertSkill("design", 7);     w.insertSkill("bi", 7);
-    w.insertSkill("computer", 7);   w.insertSkill("system", 7);
-    w.insertSkill("cleaning", 6);   w.insertSkill("rest", 6);
-    w.insertSkill("tableau", 6);    w.insertSkill("spring", 6);
-    w.insertSkill("excel", 6);      w.insertSkill("reporting", 6);
-    w.insertSkill("statistics", 5); w.insertSkill("pandas", 5);
-    w.insertSkill("nlp", 5);        w.insertSkill("keras", 5);
-    w.insertSkill("java", 8);       w.insertSkill("javascript", 7);
-    w.insertSkill("c++", 8);        w.insertSkill("html", 6);
-    w.insertSkill("css", 6);        w.insertSkill("api", 6);
-    w.insertSkill("leadership", 6); w.insertSkill("communication", 6);
-    w.insertSkill("teamwork", 5);   w.insertSkill("problem", 7);
-    w.insertSkill("analytical", 7);
-}
+// pick the list layout at build time: g++ -DUNROLLED_LISTS ... for the unrolled one.
+// resume scoring goes through the shared matching engine, its skill masks kept
+// in the same layout as the records
+#ifdef UNROLLED_LISTS
+template <typename T> using RecordList = UnrolledLinkedList<T, 32>;
+typedef MatchingEngine<UnrolledStorage<32>, KeywordDictionary, KeywordScoring> ResumeEngine;
+#else
+template <typename T> using RecordList = SinglyLinkedList<T>;
+typedef MatchingEngine<ListStorage, KeywordDictionary, KeywordScoring> ResumeEngine;
+#endif
+
+inline const string& nodeId(const JobNode* n) { return n->jobId; }
+inline const string& nodeId(const ResumeNode* n) { return n->resumeId; }
+
+// side index over a list: chunked pointer array (position -> record) and an
+// open addressing hash (id -> record), both filled on append. the list itself
+// stays the storage, the index only holds pointers into it
+template <typename Node>
+class NodeIndex {
+    static const int CHUNK_BITS = 10;
+    static const int CHUNK_SIZE = 1 << CHUNK_BITS;
+
+    Node*** chunks = NULL;   // directory of fixed size pointer chunks, never moved
+    int chunkCount = 0, chunkCapacity = 0, count = 0;
+    Node** table = NULL;     // hash slots, NULL = empty
+    size_t tableSize = 0;    // power of two, kept at most half full
+
+    void insertHash(Node* n) {
+        size_t mask = tableSize - 1;
+        size_t h = hash<string>()(nodeId(n)) & mask;
+        while (table[h]) h = (h + 1) & mask;
+        table[h] = n;
+    }
+
+    void growHash() {
+        Node** old = table;
+        size_t oldSize = tableSize;
+        tableSize = tableSize ? tableSize * 2 : 64;
+        table = new Node*[tableSize]();
+        for (size_t i = 0; i < oldSize; i++) if (old[i]) insertHash(old[i]);
+        delete[] old;
+    }
 
-//keyword scoring linked-list traversal
-double calculateWeightedScore(string resume, string job, SkillWeightLinkedList& weights) {
-    transform(resume.begin(), resume.end(), resume.begin(), ::tolower);
-    transform(job.begin(), job.end(), job.begin(), ::tolower);
+public:
+    NodeIndex() {}
+    NodeIndex(const NodeIndex&) = delete;
+    NodeIndex& operator=(const NodeIndex&) = delete;
+
+    ~NodeIndex() {
+        for (int c = 0; c < chunkCount; c++) delete[] chunks[c];
+        delete[] chunks;
+        delete[] table;
+    }
 
-    double totalWeight = 0.0;
-    double matchedWeight = 0.0;
-    int jobSkillCount = 0;
+    void add(Node* n) {
+        if (count == chunkCount * CHUNK_SIZE) {
+            if (chunkCount == chunkCapacity) {
+                // only the small directory is copied, chunks stay where they are
+                chunkCapacity = chunkCapacity ? chunkCapacity * 2 : 8;
+                Node*** grown = new Node**[chunkCapacity];
+                for (int c = 0; c < chunkCount; c++) grown[c] = chunks[c];
+                delete[] chunks;
+                chunks = grown;
+            }
+            chunks[chunkCount++] = new Node*[CHUNK_SIZE];
+        }
+        chunks[count >> CHUNK_BITS][count & (CHUNK_SIZE - 1)] = n;
+        count++;
+        if (size_t(count) * 2 > tableSize) growHash();
+        insertHash(n);
+    }
 
-    //  totals and which skills appear in job
-    for (SkillWeightNode* p = weights.head; p; p = p->next) {
-        totalWeight += p->weight;
-        if (job.find(p->skill) != string::npos) jobSkillCount++;
+    // 0-based position, NULL when out of range
+    Node* at(int i) const {
+        if (i < 0 || i >= count) return NULL;
+        return chunks[i >> CHUNK_BITS][i & (CHUNK_SIZE - 1)];
     }
 
-    // matches + small penalty for job-only skills
-    for (SkillWeightNode* p = weights.head; p; p = p->next) {
-        bool jobHas = (job.find(p->skill) != string::npos);
-        if (!jobHas) continue;
-        bool resHas = (resume.find(p->skill) != string::npos);
-        if (resHas) matchedWeight += p->weight;
-        else matchedWeight -= p->weight * 0.3;
+    // first node appended with this id, NULL if none
+    Node* find(const string& id) const {
+        if (!tableSize) return NULL;
+        size_t mask = tableSize - 1;
+        for (size_t h = hash<string>()(id) & mask; table[h]; h = (h + 1) & mask) {
+            if (nodeId(table[h]) == id) return table[h];
+        }
+        return NULL;
     }
+};
 
-    if (totalWeight <= 0.0) return 0.0;
-    double score = (matchedWeight / totalWeight) * 100.0;
-    if (jobSkillCount > 0 && matchedWeight >= totalWeight) score = 100.0;
-    if (score < 0.0) score = 0.0;
-    if (score > 100.0) score = 100.0;
-    return score;
-}
+// lists for jobs and resumes
+class JobLinkedList : public RecordList<JobNode> {
+public:
+    NodeIndex<JobNode> index;   // kept in sync by append
+
+    JobNode& append(JobNode n) {
+        JobNode& stored = RecordList<JobNode>::append(std::move(n));
+        index.add(&stored);
+        return stored;
+    }
+};
+
+class ResumeLinkedList : public RecordList<ResumeNode> {
+public:
+    NodeIndex<ResumeNode> index;   // kept in sync by append
+
+    ResumeNode& append(ResumeNode n) {
+        ResumeNode& stored = RecordList<ResumeNode>::append(std::move(n));
+        index.add(&stored);
+        return stored;
+    }
+};
 
 // load job and resume csv, skipping header row
 void loadJobs(JobLinkedList& jobs) {
@@ -129,24 +238,20 @@ void loadJobs(JobLinkedList& jobs) {
     string line; int idx = 1;
     getline(f, line); // header
     while (getline(f, line)) {
-        JobNode* n = new JobNode{"job_" + to_string(idx++), line, NULL};
-        if (!jobs.head) jobs.head = jobs.tail = n;
-        else { jobs.tail->next = n; jobs.tail = n; }
-        jobs.size++;
+        jobs.append(JobNode{"job_" + to_string(idx++), line});
     }
     f.close();
 }
 
-void loadResumes(ResumeLinkedList& resumes) {
+// every resume is also encoded into the engine, at the same position as in the list
+void loadResumes(ResumeLinkedList& resumes, ResumeEngine& engine) {
     ifstream f("data/resume.csv");
     if (!f.is_open()) { cerr << "cannot open resume.csv\n"; return; }
     string line; int idx = 1;
     getline(f, line); // header
     while (getline(f, line)) {
-        ResumeNode* n = new ResumeNode{"resume_" + to_string(idx++), line, NULL};
-        if (!resumes.head) resumes.head = resumes.tail = n;
-        else { resumes.tail->next = n; resumes.tail = n; }
-        resumes.size++;
+        resumes.append(ResumeNode{"resume_" + to_string(idx++), line});
+        engine.addResume(line);
     }
     f.close();
 }
@@ -179,18 +284,64 @@ void bubbleSortListDesc(TopMatchNode*& head){
     } while (swapped);
 }
 
+// result order: score desc, ties by id asc
+inline bool resultBefore(const TopMatchNode* a, const TopMatchNode* b) {
+    return a->score > b->score || (a->score == b->score && a->id < b->id);
+}
+
+// cut the list after n nodes and return the rest
+TopMatchNode* splitAfter(TopMatchNode* head, int n) {
+    for (int i = 1; head && i < n; i++) head = head->next;
+    if (!head) return NULL;
+    TopMatchNode* rest = head->next;
+    head->next = NULL;
+    return rest;
+}
+
+// merge two sorted runs behind tail, return the new tail. left wins ties, so stable
+TopMatchNode* mergeRuns(TopMatchNode* left, TopMatchNode* right, TopMatchNode* tail) {
+    while (left && right) {
+        if (resultBefore(right, left)) { tail->next = right; right = right->next; }
+        else { tail->next = left; left = left->next; }
+        tail = tail->next;
+    }
+    tail->next = left ? left : right;
+    while (tail->next) tail = tail->next;
+    return tail;
+}
+
+// bottom-up merge sort of the results list: runs of 1, 2, 4, ... merged by
+// relinking nodes in place, O(n log n) time and no extra memory
+void mergeSortListDesc(TopMatchNode*& head){
+    int length = 0;
+    for (TopMatchNode* p = head; p; p = p->next) length++;
+
+    TopMatchNode dummy{ "", 0.0, head };
+    for (int width = 1; width < length; width *= 2) {
+        TopMatchNode* tail = &dummy;
+        TopMatchNode* cur = dummy.next;
+        while (cur) {
+            TopMatchNode* left = cur;
+            TopMatchNode* right = splitAfter(left, width);
+            cur = splitAfter(right, width);
+            tail = mergeRuns(left, right, tail);
+        }
+    }
+    head = dummy.next;
+}
+
 // free a results list
 void freeTopList(TopMatchNode*& head){
     while (head) { TopMatchNode* d = head; head = head->next; delete d; }
 }
 
-// option 1: selected resume vs all jobs, bubble sort, then prints top 5 results
+// option 1: selected resume vs all jobs, merge sort, then prints top 5 results.
+// the resume is encoded once and scored against each job by the engine
 void findTopJobsForResume(ResumeLinkedList &resumes, JobLinkedList &jobs,
-                          SkillWeightLinkedList &skills, int resumeIndex) {
+                          ResumeEngine &engine, int resumeIndex) {
 
-    // find target resume by linear search
-    ResumeNode* r = resumes.head;
-    for (int i = 1; i < resumeIndex && r; i++) r = r->next;
+    // find target resume through the position index
+    ResumeNode* r = resumes.index.at(resumeIndex - 1);
     if (!r) { cout << "resume not found.\n"; return; }
 
     int scanned = 0, positive = 0;
@@ -199,16 +350,17 @@ void findTopJobsForResume(ResumeLinkedList &resumes, JobLinkedList &jobs,
     TopMatchNode* lst = NULL;
     TopMatchNode* tail = NULL;
 
-    for (JobNode* j = jobs.head; j; j = j->next) {
-        double s = calculateWeightedScore(r->resumeDescription, j->jobDescription, skills);
-        pushResult(lst, tail, j->jobId, s);
+    uint64_t resumeMask = engine.encodeResume(r->resumeDescription);
+    for (const JobNode& j : jobs) {
+        double s = engine.scoreResume(j.jobDescription, resumeMask);
+        pushResult(lst, tail, j.jobId, s);
         if (s > 0.0) positive++;
         scanned++;
     }
     clock_t scanEnd = clock();
 
     clock_t sortBeg = clock();
-    bubbleSortListDesc(lst);        // full-list sort
+    mergeSortListDesc(lst);         // full-list sort
     clock_t sortEnd = clock();
 
     cout.setf(std::ios::fixed);
@@ -222,18 +374,18 @@ void findTopJobsForResume(ResumeLinkedList &resumes, JobLinkedList &jobs,
     cout << "Scanned jobs: " << scanned
          << "  | Positive matches (>0): " << positive << "\n";
     cout << "Time (scan): " << double(scanEnd - scanBeg)/CLOCKS_PER_SEC << " s\n";
-    cout << "Time (bubble sort full list): " << double(sortEnd - sortBeg)/CLOCKS_PER_SEC << " s\n";
+    cout << "Time (merge sort full list): " << setprecision(4) << double(sortEnd - sortBeg)/CLOCKS_PER_SEC << " s\n";
 
     freeTopList(lst);
 }
 
-// option 2: selected job vs all resume, bubble sort, then prints top 5 results
+// option 2: selected job vs all resume, merge sort, then prints top 5 results.
+// the engine scores every resume, then the results list is built in list order
 void findTopResumesForJob(ResumeLinkedList &resumes, JobLinkedList &jobs,
-                          SkillWeightLinkedList &skills, int jobIndex) {
+                          ResumeEngine &engine, int jobIndex) {
 
-    // find target job by linear search
-    JobNode* j = jobs.head;
-    for (int i = 1; i < jobIndex && j; i++) j = j->next;
+    // find target job through the position index
+    JobNode* j = jobs.index.at(jobIndex - 1);
     if (!j) { cout << "job not found.\n"; return; }
 
     int scanned = 0, positive = 0;
@@ -242,16 +394,19 @@ void findTopResumesForJob(ResumeLinkedList &resumes, JobLinkedList &jobs,
     TopMatchNode* lst = NULL;
     TopMatchNode* tail = NULL;
 
-    for (ResumeNode* r = resumes.head; r; r = r->next) {
-        double s = calculateWeightedScore(r->resumeDescription, j->jobDescription, skills);
-        pushResult(lst, tail, r->resumeId, s);
+    float* scores = new float[resumes.size];
+    engine.scoreAll(j->jobDescription, scores);
+    for (const ResumeNode& r : resumes) {
+        double s = scores[scanned];
+        pushResult(lst, tail, r.resumeId, s);
         if (s > 0.0) positive++;
         scanned++;
     }
+    delete[] scores;
     clock_t scanEnd = clock();
 
     clock_t sortBeg = clock();
-    bubbleSortListDesc(lst);        // full-list sort 
+    mergeSortListDesc(lst);         // full-list sort 
     clock_t sortEnd = clock();
 
     cout.setf(std::ios::fixed);
@@ -265,30 +420,33 @@ void findTopResumesForJob(ResumeLinkedList &resumes, JobLinkedList &jobs,
     cout << "Scanned resumes: " << scanned
          << "  | Positive matches (>0): " << positive << "\n";
     cout << "Time (scan): " << double(scanEnd - scanBeg)/CLOCKS_PER_SEC << " s\n";
-    cout << "Time (bubble sort full list): " << double(sortEnd - sortBeg)/CLOCKS_PER_SEC << " s\n";
+    cout << "Time (merge sort full list): " << setprecision(4) << double(sortEnd - sortBeg)/CLOCKS_PER_SEC << " s\n";
 
     freeTopList(lst);
 }
 
-// option 3: performance test, 10 jobs × all resumes
-void runPerformanceTest(JobLinkedList& jobs, ResumeLinkedList& resumes, SkillWeightLinkedList& skills) {
+// option 3: performance test, 10 jobs × all resumes, scored by the engine
+void runPerformanceTest(JobLinkedList& jobs, ResumeLinkedList& resumes, ResumeEngine& engine) {
     cout << "\n=== Performance Test (full linked-list sort) ===\n";
-    if (!jobs.head || !resumes.head) { cout << "no data loaded.\n"; return; }
+    if (jobs.size == 0 || resumes.size == 0) { cout << "no data loaded.\n"; return; }
+    cout << "list layout: " << ResumeLinkedList::layout() << "\n";
 
     int jobsToTest = 10;
-    double totalScan = 0.0, totalSort = 0.0, totalAll = 0.0;
+    double totalScan = 0.0, totalSort = 0.0, totalAll = 0.0, bubbleTime = 0.0;
+    float* scores = new float[resumes.size];
 
-    JobNode* j = jobs.head;
-    for (int ji = 1; ji <= jobsToTest && j; ++ji, j = j->next) {
+    JobNode* j = NULL;
+    for (int ji = 1; ji <= jobsToTest && (j = jobs.index.at(ji - 1)); ++ji) {
         clock_t scanBeg = clock();
 
         TopMatchNode* lst = NULL;
         TopMatchNode* tail = NULL;
 
-        int matches = 0;
-        for (ResumeNode* r = resumes.head; r; r = r->next) {
-            double s = calculateWeightedScore(r->resumeDescription, j->jobDescription, skills);
-            pushResult(lst, tail, r->resumeId, s);
+        int matches = 0, ri = 0;
+        engine.scoreAll(j->jobDescription, scores);
+        for (const ResumeNode& r : resumes) {
+            double s = scores[ri++];
+            pushResult(lst, tail, r.resumeId, s);
             if (s > 0.0) matches++;
         }
 
@@ -296,10 +454,21 @@ void runPerformanceTest(JobLinkedList& jobs, ResumeLinkedList& resumes, SkillWei
         double scanTime = double(scanEnd - scanBeg) / CLOCKS_PER_SEC;
 
         clock_t sortBeg = clock();
-        bubbleSortListDesc(lst);                  // full-list sort
+        mergeSortListDesc(lst);                   // full-list sort
         clock_t sortEnd = clock();
         double sortTime = double(sortEnd - sortBeg) / CLOCKS_PER_SEC;
 
+        if (ji == 1) {
+            // same list through the old bubble sort, for comparison
+            TopMatchNode* copy = NULL;
+            TopMatchNode* copyTail = NULL;
+            for (TopMatchNode* p = lst; p; p = p->next) pushResult(copy, copyTail, p->id, p->score);
+            clock_t bubbleBeg = clock();
+            bubbleSortListDesc(copy);
+            bubbleTime = double(clock() - bubbleBeg) / CLOCKS_PER_SEC;
+            freeTopList(copy);
+        }
+
         // touch top 5 (optional read)
         int shown = 0; for (TopMatchNode* p = lst; p && shown < 5; p = p->next, ++shown) {}
 
@@ -310,12 +479,13 @@ void runPerformanceTest(JobLinkedList& jobs, ResumeLinkedList& resumes, SkillWei
 
         cout << "job " << ji << ": " << matches
              << " matches | scan " << fixed << setprecision(2) << scanTime
-             << " s | sort " << sortTime << " s | total "
+             << " s | sort " << setprecision(4) << sortTime << " s | total "
              << setprecision(2) << total << " s\n";
     }
 
     cout << "\navg scan per job: " << fixed << setprecision(2) << (totalScan / jobsToTest) << " s\n";
-    cout << "avg full-list bubble sort per job: " << fixed << setprecision(2) << (totalSort / jobsToTest) << " s\n";
+    cout << "avg full-list merge sort per job: " << fixed << setprecision(4) << (totalSort / jobsToTest) << " s"
+         << " (bubble sort, job 1: " << bubbleTime << " s)\n";
     cout << "avg total per job: " << fixed << setprecision(2) << (totalAll / jobsToTest) << " s\n";
 
     // classic estimate line (same style as your screenshot)
@@ -324,20 +494,106 @@ void runPerformanceTest(JobLinkedList& jobs, ResumeLinkedList& resumes, SkillWei
     };
     cout << "Total memory used: ~" << fixed << setprecision(0)
          << estimateMemoryKB(jobs.size, resumes.size) << " KB (estimated)\n";
+
+    // bare traversal cost of the list layout, no scoring
+    const int walks = 100;
+    size_t chars = 0;
+    clock_t walkBeg = clock();
+    for (int w = 0; w < walks; w++)
+        for (const ResumeNode& r : resumes) chars += r.resumeDescription.size();
+    double walkTime = double(clock() - walkBeg) / CLOCKS_PER_SEC;
+    cout << "list walk: " << setprecision(4) << walkTime * 1000.0 / walks << " ms per pass over "
+         << resumes.size << " resumes (" << chars / walks << " chars)\n";
+
+    // full ranking export size: 1,000,000 results (100 x the job 1 scores)
+    TopMatchNode* big = NULL;
+    TopMatchNode* bigTail = NULL;
+    engine.scoreAll(jobs.index.at(0)->jobDescription, scores);
+    int ri = 0;
+    for (const ResumeNode& r : resumes) {
+        double s = scores[ri++];
+        for (int copy = 0; copy < 100; copy++) pushResult(big, bigTail, r.resumeId + "_" + to_string(copy), s);
+    }
+    clock_t bigBeg = clock();
+    mergeSortListDesc(big);
+    double bigTime = double(clock() - bigBeg) / CLOCKS_PER_SEC;
+    bool ordered = true;
+    for (TopMatchNode* p = big; p && p->next; p = p->next) if (resultBefore(p->next, p)) { ordered = false; break; }
+    cout << "merge sort of " << resumes.size * 100 << " results: " << setprecision(3) << bigTime
+         << " s (" << (ordered ? "ordered" : "NOT ordered") << ")\n";
+    freeTopList(big);
+    delete[] scores;
 }
 
 
+// option 5: shared scan, one pass over the resumes for all test jobs: the
+// engine gathers each block of resume masks once and scores it for every job,
+// keeping a top-5 heap per job (ties go to the earlier resume)
+void runSharedScanTest(JobLinkedList& jobs, ResumeLinkedList& resumes, ResumeEngine& engine) {
+    cout << "\n=== Shared Scan Test (10 jobs, one pass over resumes) ===\n";
+    if (jobs.size == 0 || resumes.size == 0) { cout << "no data loaded.\n"; return; }
+
+    const int jobsToTest = 10, topN = 5;
+    string jobText[jobsToTest];
+    string jobId[jobsToTest];
+    TopKHeap* top[jobsToTest];
+    int matches[jobsToTest];
+
+    int batch = 0;
+    for (JobNode* j; batch < jobsToTest && (j = jobs.index.at(batch)); ++batch) {
+        jobText[batch] = j->jobDescription;
+        jobId[batch] = j->jobId;
+        top[batch] = new TopKHeap(topN); matches[batch] = 0;
+    }
+
+    clock_t scanBeg = clock();
+    engine.scoreShared(jobText, batch, [&](int b, int first, const float* scores, int count) {
+        for (int i = 0; i < count; i++) {
+            if (scores[i] > 0.0f) matches[b]++;
+            top[b]->offer(first + i, scores[i]);
+        }
+    });
+    clock_t scanEnd = clock();
+
+    cout.setf(std::ios::fixed);
+    cout << setprecision(2);
+    ScoredIndex best[topN];
+    for (int b = 0; b < batch; b++) {
+        cout << jobId[b] << ": " << matches[b] << " matches | best:";
+        int kept = top[b]->sorted(best);
+        for (int i = 0; i < kept; i++)
+            cout << " " << resumes.index.at(best[i].index)->resumeId << " (" << best[i].score << ")";
+        cout << "\n";
+        delete top[b];
+    }
+
+    double scanTime = double(scanEnd - scanBeg) / CLOCKS_PER_SEC;
+    cout << "\nresume list walked once for " << batch << " jobs in " << scanTime << " s"
+         << " (avg " << setprecision(4) << (batch > 0 ? scanTime / batch : 0.0) << " s per job)\n";
+}
+
+// option 6: id lookup through the hash index, e.g. resume_4821 or job_17
+void lookupById(JobLinkedList& jobs, ResumeLinkedList& resumes, const string& id) {
+    clock_t beg = clock();
+    const string* text = NULL;
+    if (JobNode* j = jobs.index.find(id)) text = &j->jobDescription;
+    else if (ResumeNode* r = resumes.index.find(id)) text = &r->resumeDescription;
+    double t = double(clock() - beg) / CLOCKS_PER_SEC;
+
+    if (!text) { cout << "id not found.\n"; return; }
+    cout << id << ": " << text->substr(0, 100) << "...\n";
+    cout << "Time (lookup): " << fixed << setprecision(6) << t << " s\n";
+}
 
 int main() {
     JobLinkedList jobs;
     ResumeLinkedList resumes;
-    SkillWeightLinkedList skills;
-    initializeSkillWeights(skills);
+    ResumeEngine engine;
 
     cout << "loading job descriptions...\n";
     loadJobs(jobs);
     cout << "loading resumes...\n";
-    loadResumes(resumes);
+    loadResumes(resumes, engine);
     cout << "data loaded. jobs=" << jobs.size << " resumes=" << resumes.size << "\n";
 
     int choice;
@@ -347,6 +603,8 @@ int main() {
         cout << "2. top 5 candidates for a job (full-list sort)\n";
         cout << "3. run performance test (10 x all resumes, full-list sort)\n";
         cout << "4. exit\n";
+        cout << "5. shared-scan test (10 jobs, one pass over resumes, top 5 each)\n";
+        cout << "6. look up a job or resume by id (e.g. resume_4821)\n";
         cout << "enter choice: ";
         cin >> choice;
 
@@ -354,14 +612,21 @@ int main() {
             int idx;
             cout << "enter resume index (1-" << resumes.size << "): ";
             cin >> idx;
-            findTopJobsForResume(resumes, jobs, skills, idx);
+            findTopJobsForResume(resumes, jobs, engine, idx);
         } else if (choice == 2) {
             int idx;
             cout << "enter job index (1-" << jobs.size << "): ";
             cin >> idx;
-            findTopResumesForJob(resumes, jobs, skills, idx);
+            findTopResumesForJob(resumes, jobs, engine, idx);
         } else if (choice == 3) {
-            runPerformanceTest(jobs, resumes, skills);
+            runPerformanceTest(jobs, resumes, engine);
+        } else if (choice == 5) {
+            runSharedScanTest(jobs, resumes, engine);
+        } else if (choice == 6) {
+            string id;
+            cout << "enter id: ";
+            cin >> id;
+            lookupById(jobs, resumes, id);
         } else if (choice == 4) {
             cout << "bye\n";
         } else {
@@ -0,0 +1,538 @@
+#ifndef MATCHING_ENGINE_H
+#define MATCHING_ENGINE_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "JobMatchingArray.h"
+#include "SkillDictionary.h"
+#include "BatchScorer.h"
+#include "TopK.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#include <stdlib.h>
+#endif
+
+// One matching core for every layout and formula:
+//
+//   MatchingEngine<Storage, Dictionary, Scoring>
+//
+// Storage    where the encoded resumes live (ArrayStorage, ListStorage,
+//            UnrolledStorage<N>, MappedStorage)
+// Dictionary how text becomes skills (CategorySkillDictionary: the array
+//            program's SkillDictionary; KeywordDictionary: the linked-list
+//            program's weighted keywords)
+// Scoring    how a job and a resume become a score (WeightedScoring: the array
+//            formula; KeywordScoring: the linked-list formula)
+//
+// Every policy is a plain class used through templates, so each combination is
+// compiled and inlined separately with no virtual calls. Resumes are stored as
+// 64-bit skill masks and jobs as EncodedJob in all combinations, so two engines
+// that differ only in Storage do exactly the same scoring work. Scans gather the
+// masks into blocks and score a whole block per call, so WeightedScoring runs on
+// the widest batch kernel the CPU has.
+
+// ---- storage policies --------------------------------------------------------
+// Each provides append(mask), getSize(), seal() (called before every scan) and
+// forEach(visit) which calls visit(index, mask) in index order.
+
+// Contiguous array with capacity doubling
+class ArrayStorage {
+private:
+    uint64_t* masks;
+    int capacity;
+    int size;
+
+public:
+    ArrayStorage() : capacity(16), size(0) {
+        masks = new uint64_t[capacity];
+    }
+
+    ~ArrayStorage() {
+        delete[] masks;
+    }
+
+    ArrayStorage(const ArrayStorage&) = delete;
+    ArrayStorage& operator=(const ArrayStorage&) = delete;
+
+    void append(uint64_t mask) {
+        if (size >= capacity) {
+            capacity *= 2;
+            uint64_t* grown = new uint64_t[capacity];
+            std::memcpy(grown, masks, sizeof(uint64_t) * size);
+            delete[] masks;
+            masks = grown;
+        }
+        masks[size++] = mask;
+    }
+
+    void seal() {}
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (int i = 0; i < size; i++) visit(i, masks[i]);
+    }
+
+    int getSize() const { return size; }
+    static const char* name() { return "array"; }
+};
+
+// Classic singly linked list, one resume per node
+class ListStorage {
+private:
+    struct Node {
+        uint64_t mask;
+        Node* next;
+    };
+
+    Node* head;
+    Node* tail;
+    int size;
+
+public:
+    ListStorage() : head(NULL), tail(NULL), size(0) {}
+
+    ~ListStorage() {
+        while (head) {
+            Node* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    ListStorage(const ListStorage&) = delete;
+    ListStorage& operator=(const ListStorage&) = delete;
+
+    void append(uint64_t mask) {
+        Node* node = new Node{mask, NULL};
+        if (!head) head = tail = node;
+        else { tail->next = node; tail = node; }
+        size++;
+    }
+
+    void seal() {}
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        int index = 0;
+        for (Node* node = head; node; node = node->next) visit(index++, node->mask);
+    }
+
+    int getSize() const { return size; }
+    static const char* name() { return "list"; }
+};
+
+// Unrolled linked list: up to CAP resumes per node
+template <int CAP>
+class UnrolledStorage {
+private:
+    struct Block {
+        uint64_t masks[CAP];
+        int count;
+        Block* next;
+    };
+
+    Block* head;
+    Block* tail;
+    int size;
+
+public:
+    UnrolledStorage() : head(NULL), tail(NULL), size(0) {}
+
+    ~UnrolledStorage() {
+        while (head) {
+            Block* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    UnrolledStorage(const UnrolledStorage&) = delete;
+    UnrolledStorage& operator=(const UnrolledStorage&) = delete;
+
+    void append(uint64_t mask) {
+        if (!tail || tail->count == CAP) {
+            Block* block = new Block();
+            if (!head) head = tail = block;
+            else { tail->next = block; tail = block; }
+        }
+        tail->masks[tail->count++] = mask;
+        size++;
+    }
+
+    void seal() {}
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        int index = 0;
+        for (Block* block = head; block; block = block->next) {
+            for (int i = 0; i < block->count; i++) visit(index++, block->masks[i]);
+        }
+    }
+
+    int getSize() const { return size; }
+    static const char* name() { return "unrolled list"; }
+};
+
+#ifndef _WIN32
+// Masks written to an unlinked temporary file and scanned through a read-only
+// memory mapping, so the OS pages them in and out instead of the heap holding
+// them. Appends are buffered; seal() flushes and (re)maps.
+class MappedStorage {
+private:
+    static const int BUFFER_SIZE = 4096;
+
+    int fd;
+    uint64_t pending[BUFFER_SIZE];
+    int pendingCount;
+    const uint64_t* mapped;
+    int mappedCount;
+    int size;
+
+    void unmap() {
+        if (mapped) {
+            munmap(const_cast<uint64_t*>(mapped), sizeof(uint64_t) * mappedCount);
+            mapped = NULL;
+            mappedCount = 0;
+        }
+    }
+
+    void flush() {
+        const char* data = reinterpret_cast<const char*>(pending);
+        size_t remaining = sizeof(uint64_t) * pendingCount;
+        while (remaining > 0) {
+            ssize_t written = write(fd, data, remaining);
+            if (written <= 0) {
+                throw std::runtime_error("Cannot write mapped resume storage");
+            }
+            data += written;
+            remaining -= written;
+        }
+        pendingCount = 0;
+    }
+
+public:
+    MappedStorage() : pendingCount(0), mapped(NULL), mappedCount(0), size(0) {
+        char path[] = "/tmp/job_matching_masks_XXXXXX";
+        fd = mkstemp(path);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create mapped resume storage");
+        }
+        unlink(path);   // the file lives until fd is closed
+    }
+
+    ~MappedStorage() {
+        unmap();
+        close(fd);
+    }
+
+    MappedStorage(const MappedStorage&) = delete;
+    MappedStorage& operator=(const MappedStorage&) = delete;
+
+    void append(uint64_t mask) {
+        pending[pendingCount++] = mask;
+        size++;
+        if (pendingCount == BUFFER_SIZE) {
+            flush();
+        }
+    }
+
+    void seal() {
+        if (mappedCount == size) return;
+        flush();
+        unmap();
+        if (size == 0) return;
+        void* region = mmap(NULL, sizeof(uint64_t) * size, PROT_READ, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            throw std::runtime_error("Cannot map resume storage");
+        }
+        mapped = static_cast<const uint64_t*>(region);
+        mappedCount = size;
+    }
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (int i = 0; i < mappedCount; i++) visit(i, mapped[i]);
+    }
+
+    int getSize() const { return size; }
+    static const char* name() { return "memory-mapped"; }
+};
+#else
+// No mmap: fall back to the heap array
+typedef ArrayStorage MappedStorage;
+#endif
+
+// ---- dictionary policies -----------------------------------------------------
+// Each provides encodeJob(text) -> EncodedJob, encodeResume(text) -> mask and
+// totalWeight() (sum of the weights of every dictionary skill).
+
+// The array program's skill taxonomy: whole-word matches, synonyms, weights
+// from skillCategories, duplicated job skills counted
+class CategorySkillDictionary {
+private:
+    SkillDictionary skills;
+    float total;
+
+public:
+    CategorySkillDictionary() : total(static_cast<float>(skills.getTotalSkillWeight())) {}
+
+    EncodedJob encodeJob(const std::string& text) const { return skills.encodeJob(text); }
+    uint64_t encodeResume(const std::string& text) const { return skills.encodeResume(text); }
+    float totalWeight() const { return total; }
+    static const char* name() { return "category skills"; }
+};
+
+// The linked-list program's weighted keywords, matched as substrings of the
+// lowercased text. This is the program's only keyword table.
+class KeywordDictionary {
+private:
+    static const int KEYWORD_COUNT = 41;
+    std::string keywords[KEYWORD_COUNT];
+    double weights[KEYWORD_COUNT];
+    float total;
+
+    uint64_t encode(const std::string& text) const {
+        std::string lower = text;
+        for (char& c : lower) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        uint64_t mask = 0;
+        for (int i = 0; i < KEYWORD_COUNT; i++) {
+            if (lower.find(keywords[i]) != std::string::npos) mask |= 1ull << i;
+        }
+        return mask;
+    }
+
+public:
+    KeywordDictionary() : total(0.0f) {
+        // the position of each keyword is its bit in a resume mask
+        static const struct { const char* keyword; double weight; } table[KEYWORD_COUNT] = {
+            {"data", 10},       {"sql", 10},
+            {"agile", 9},       {"learning", 9},
+            {"product", 9},     {"python", 9},
+            {"engineer", 8},    {"management", 8},
+            {"power", 8},       {"machine", 8},
+            {"stories", 7},     {"user", 7},
+            {"stakeholder", 7}, {"scrum", 7},
+            {"roadmap", 7},     {"deep", 7},
+            {"design", 7},      {"bi", 7},
+            {"computer", 7},    {"system", 7},
+            {"cleaning", 6},    {"rest", 6},
+            {"tableau", 6},     {"spring", 6},
+            {"excel", 6},       {"reporting", 6},
+            {"statistics", 5},  {"pandas", 5},
+            {"nlp", 5},         {"keras", 5},
+            {"java", 8},        {"javascript", 7},
+            {"c++", 8},         {"html", 6},
+            {"css", 6},         {"api", 6},
+            {"leadership", 6},  {"communication", 6},
+            {"teamwork", 5},    {"problem", 7},
+            {"analytical", 7}
+        };
+        double sum = 0.0;
+        for (int i = 0; i < KEYWORD_COUNT; i++) {
+            keywords[i] = table[i].keyword;
+            weights[i] = table[i].weight;
+            sum += table[i].weight;
+        }
+        total = static_cast<float>(sum);
+    }
+
+    EncodedJob encodeJob(const std::string& text) const {
+        uint64_t mask = encode(text);
+        EncodedJob job;
+        for (int i = 0; i < KEYWORD_COUNT; i++) {
+            if (mask & (1ull << i)) job.addSkill(i, 1, weights[i]);
+        }
+        return job;
+    }
+
+    uint64_t encodeResume(const std::string& text) const { return encode(text); }
+    float totalWeight() const { return total; }
+    static const char* name() { return "keywords"; }
+};
+
+// ---- scoring policies --------------------------------------------------------
+// Each provides scoreBlock(job, lo, hi, count, out, dictionary), scoring `count`
+// resumes given as the low and high words of their masks.
+
+// The array formula (30% penalty, 80% bonus capped at 95, 100 only when every
+// required skill is present), run by the batch kernels
+struct WeightedScoring {
+    template <typename Dictionary>
+    static void scoreBlock(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                           int count, float* out, const Dictionary&) {
+        BatchScorer::scoreBlock(job, lo, hi, count, out);
+    }
+
+    static const char* name() { return "weighted"; }
+};
+
+// The linked-list formula: matched minus 30% of missing job weight, relative to
+// the weight of the whole dictionary
+struct KeywordScoring {
+    template <typename Dictionary>
+    static void scoreBlock(const EncodedJob& job, const uint32_t* lo, const uint32_t* hi,
+                           int count, float* out, const Dictionary& dictionary) {
+        float total = dictionary.totalWeight();
+        for (int i = 0; i < count; i++) {
+            if (job.termCount == 0 || total <= 0.0f) {
+                out[i] = 0.0f;
+                continue;
+            }
+            uint32_t words[2] = {lo[i], hi[i]};
+            float acc = job.missingAcc;
+            for (int t = 0; t < job.termCount; t++) {
+                if (words[job.terms[t].word] & job.terms[t].bit) acc += job.terms[t].delta;
+            }
+            float score = acc / total * 100.0f;
+            out[i] = acc >= total ? 100.0f : (score < 0.0f ? 0.0f : (score > 100.0f ? 100.0f : score));
+        }
+    }
+
+    static const char* name() { return "keyword"; }
+};
+
+// ---- engine --------------------------------------------------------------------
+
+template <typename Storage, typename Dictionary = CategorySkillDictionary, typename Scoring = WeightedScoring>
+class MatchingEngine {
+private:
+    static const int BLOCK_SIZE = 256;   // resumes per scoring call
+
+    Dictionary dictionary;
+    Storage resumes;
+    DynamicArray jobs;
+
+    // Scores every resume against each of `jobCount` jobs one block at a time
+    // and calls visit(jobSlot, firstIndex, scores, count) for each block and
+    // job, in index order. A block's masks are gathered once for all the jobs.
+    template <typename Visit>
+    void scanBlocks(const EncodedJob* jobList, int jobCount, Visit visit) {
+        uint32_t lo[BLOCK_SIZE];
+        uint32_t hi[BLOCK_SIZE];
+        float scores[BLOCK_SIZE];
+        int first = 0;
+        int count = 0;
+        auto flush = [&]() {
+            for (int j = 0; j < jobCount; j++) {
+                Scoring::scoreBlock(jobList[j], lo, hi, count, scores, dictionary);
+                visit(j, first, scores, count);
+            }
+            count = 0;
+        };
+        resumes.seal();
+        resumes.forEach([&](int index, uint64_t mask) {
+            if (count == 0) first = index;
+            lo[count] = static_cast<uint32_t>(mask);
+            hi[count] = static_cast<uint32_t>(mask >> 32);
+            if (++count == BLOCK_SIZE) flush();
+        });
+        if (count > 0) flush();
+    }
+
+    // Calls visit(row) for every non-empty data row, quotes removed
+    template <typename Visit>
+    static bool readRows(const std::string& filename, Visit visit) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cout << "Error: Cannot open file " << filename << std::endl;
+            return false;
+        }
+        std::string line;
+        std::getline(file, line);   // header
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();   // CRLF files
+            if (line.empty()) continue;
+            if (line.length() >= 2 && line.front() == '"' && line.back() == '"') {
+                line = line.substr(1, line.length() - 2);
+            }
+            visit(line);
+        }
+        return true;
+    }
+
+public:
+    bool loadJobs(const std::string& filename) {
+        return readRows(filename, [this](const std::string& row) { addJob(row); });
+    }
+
+    bool loadResumes(const std::string& filename) {
+        return readRows(filename, [this](const std::string& row) { addResume(row); });
+    }
+
+    void addJob(const std::string& text) {
+        jobs.add(text);
+    }
+
+    void addResume(const std::string& text) {
+        resumes.append(dictionary.encodeResume(text));
+    }
+
+    // Best `k` resumes with a positive score, in (score desc, index asc) order
+    int topMatchesForText(const std::string& jobText, int k, ScoredIndex* out) {
+        EncodedJob job = dictionary.encodeJob(jobText);
+        TopKHeap heap(k);
+        scanBlocks(&job, 1, [&](int, int first, const float* scores, int count) {
+            for (int i = 0; i < count; i++) {
+                if (scores[i] > 0) heap.offer(first + i, scores[i]);
+            }
+        });
+        return heap.sorted(out);
+    }
+
+    // Score of every resume for one job, in index order; `scores` must hold
+    // getResumeCount() entries
+    void scoreAll(const std::string& jobText, float* scores) {
+        EncodedJob job = dictionary.encodeJob(jobText);
+        scanBlocks(&job, 1, [&](int, int first, const float* blockScores, int count) {
+            std::memcpy(scores + first, blockScores, sizeof(float) * count);
+        });
+    }
+
+    // Shared scan: scores every resume against several jobs in one pass over
+    // the storage, calling visit(jobSlot, firstIndex, scores, count)
+    template <typename Visit>
+    void scoreShared(const std::string* jobTexts, int jobCount, Visit visit) {
+        if (jobCount <= 0) return;
+        EncodedJob* encoded = new EncodedJob[jobCount];
+        for (int j = 0; j < jobCount; j++) encoded[j] = dictionary.encodeJob(jobTexts[j]);
+        scanBlocks(encoded, jobCount, visit);
+        delete[] encoded;
+    }
+
+    // A resume that is not stored, scored by the same dictionary and formula:
+    // encode it once, then score it against each job
+    uint64_t encodeResume(const std::string& text) const {
+        return dictionary.encodeResume(text);
+    }
+
+    float scoreResume(const std::string& jobText, uint64_t resumeMask) const {
+        EncodedJob job = dictionary.encodeJob(jobText);
+        uint32_t lo = static_cast<uint32_t>(resumeMask);
+        uint32_t hi = static_cast<uint32_t>(resumeMask >> 32);
+        float score;
+        Scoring::scoreBlock(job, &lo, &hi, 1, &score, dictionary);
+        return score;
+    }
+
+    int topMatches(int jobIndex, int k, ScoredIndex* out) {
+        return topMatchesForText(jobs.get(jobIndex), k, out);
+    }
+
+    int getJobCount() const { return jobs.getSize(); }
+    int getResumeCount() const { return resumes.getSize(); }
+
+    static std::string describe() {
+        return std::string(Storage::name()) + " / " + Dictionary::name() + " / " + Scoring::name();
+    }
+};
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include "JobMatchingArray.h"
+#include "TopK.h"
+#include "Wire.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Long-running matcher that keeps the loaded index resident and answers
+// top-K queries over a Unix domain socket.
+//
+// Request:  [u32 k][u32 type][type 0: u32 jobIndex (0-based) | type 1: string jobText]
+// Response: [u32 status][u32 count][count x ScoredIndex]   status 0 = ok, 1 = bad request
+//
+// Requests that arrive while a scan is running queue up in the sockets and are
+// answered together by the next shared scan (JobMatchingSystem::scanTopMatches).
+// Client sockets are non-blocking: each request is assembled in its client's
+// buffer and dispatched only once the whole frame is there, so a client that
+// sends half a frame and stalls holds up nobody else.
+namespace QueryProtocol {
+    const uint32_t BY_INDEX = 0;
+    const uint32_t BY_TEXT = 1;
+    const uint32_t STATUS_OK = 0;
+    const uint32_t STATUS_BAD_REQUEST = 1;
+    const uint32_t MAX_K = 1000;
+    // Longest well-formed request: k, type and a text of the maximum length
+    const size_t MAX_REQUEST_BYTES = 3 * sizeof(uint32_t) + Wire::MAX_TEXT_LENGTH;
+}
+
+class JobQueryServer {
+private:
+    static const int MAX_CLIENTS = 256;
+
+    struct PendingRequest {
+        int client;
+        int k;
+        bool valid;
+        std::string jobText;
+    };
+
+    JobMatchingSystem& system;
+    std::string socketPath;
+    int listenFd;
+    int clientFds[MAX_CLIENTS];
+    std::string clientInboxes[MAX_CLIENTS];   // bytes received but not yet parsed
+    bool clientEnded[MAX_CLIENTS];            // peer sent EOF: answer what is buffered, then close
+    int clientCount;
+    std::atomic<bool> stopping;
+
+    long long requestsServed;
+    long long batchesServed;
+    int largestBatch;
+
+#ifndef _WIN32
+    void closeClient(int client) {
+        close(clientFds[client]);
+        clientCount--;
+        clientFds[client] = clientFds[clientCount];
+        clientInboxes[client].swap(clientInboxes[clientCount]);
+        clientInboxes[clientCount].clear();
+        clientEnded[client] = clientEnded[clientCount];
+    }
+
+    // Appends whatever the socket holds without waiting for more. Stops once a
+    // full request's worth is buffered. EOF only sets clientEnded, so requests
+    // sent before a half-close are still answered. False on a read error.
+    bool receive(int client) {
+        char chunk[65536];
+        std::string& inbox = clientInboxes[client];
+        while (inbox.size() < QueryProtocol::MAX_REQUEST_BYTES) {
+            ssize_t n = read(clientFds[client], chunk, sizeof(chunk));
+            if (n > 0) {
+                inbox.append(chunk, static_cast<size_t>(n));
+            } else if (n == 0) {
+                clientEnded[client] = true;
+                return true;
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+        }
+        return true;
+    }
+
+    static bool takeU32(const std::string& inbox, size_t& offset, uint32_t& value) {
+        if (inbox.size() - offset < sizeof(value)) return false;
+        std::memcpy(&value, inbox.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+
+    // Parses the request at the front of `inbox`. Returns the bytes it takes up,
+    // 0 while the frame is still incomplete, or -1 if the frame is malformed.
+    long parseRequest(const std::string& inbox, PendingRequest& request) {
+        size_t offset = 0;
+        uint32_t k, type;
+        if (!takeU32(inbox, offset, k) || !takeU32(inbox, offset, type)) return 0;
+
+        request.k = static_cast<int>(k);
+        request.valid = (k >= 1 && k <= QueryProtocol::MAX_K);
+        if (type == QueryProtocol::BY_INDEX) {
+            uint32_t jobIndex;
+            if (!takeU32(inbox, offset, jobIndex)) return 0;
+            if (jobIndex < static_cast<uint32_t>(system.getJobCount())) {
+                request.jobText = system.getJobDescription(static_cast<int>(jobIndex));
+            } else {
+                request.valid = false;
+            }
+        } else if (type == QueryProtocol::BY_TEXT) {
+            uint32_t length;
+            if (!takeU32(inbox, offset, length)) return 0;
+            if (length > Wire::MAX_TEXT_LENGTH) return -1;
+            if (inbox.size() - offset < length) return 0;
+            request.jobText.assign(inbox, offset, length);
+            offset += length;
+        } else {
+            return -1;
+        }
+        return static_cast<long>(offset);
+    }
+
+    // One pass over the resumes answers every queued request; clients whose
+    // reply cannot be written, including ones that stopped reading until their
+    // socket filled up, are flagged in `dead`
+    void answerBatch(PendingRequest* requests, int count, bool* dead) {
+        EncodedJob* jobs = new EncodedJob[count];
+        TopKHeap** heaps = new TopKHeap*[count];
+        for (int i = 0; i < count; i++) {
+            heaps[i] = new TopKHeap(requests[i].valid ? requests[i].k : 0);
+            if (requests[i].valid) {
+                jobs[i] = system.encodeJobText(requests[i].jobText);
+            }
+        }
+
+        system.scanTopMatches(jobs, count, heaps);
+
+        ScoredIndex matches[QueryProtocol::MAX_K];
+        for (int i = 0; i < count; i++) {
+            int found = heaps[i]->sorted(matches);
+            int fd = clientFds[requests[i].client];
+            bool ok = Wire::writeU32(fd, requests[i].valid ? QueryProtocol::STATUS_OK
+                                                           : QueryProtocol::STATUS_BAD_REQUEST) &&
+                      Wire::writeMatches(fd, matches, found);
+            if (!ok) {
+                dead[requests[i].client] = true;
+            }
+            delete heaps[i];
+        }
+
+        requestsServed += count;
+        batchesServed++;
+        largestBatch = std::max(largestBatch, count);
+        delete[] heaps;
+        delete[] jobs;
+    }
+#endif
+
+public:
+    explicit JobQueryServer(JobMatchingSystem& matcher)
+        : system(matcher), listenFd(-1), clientCount(0), stopping(false),
+          requestsServed(0), batchesServed(0), largestBatch(0) {}
+
+    ~JobQueryServer() {
+        shutdown();
+    }
+
+    bool listenOn(const std::string& path) {
+#ifdef _WIN32
+        (void)path;
+        std::cout << "Error: server mode needs Unix domain sockets" << std::endl;
+        return false;
+#else
+        sockaddr_un address;
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cout << "Error: socket path too long: " << path << std::endl;
+            return false;
+        }
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            std::cout << "Error: cannot create socket" << std::endl;
+            return false;
+        }
+
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenFd, 64) != 0) {
+            std::cout << "Error: cannot listen on " << path << std::endl;
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+
+        socketPath = path;
+        return true;
+#endif
+    }
+
+    // Serves until stop() is called from another thread
+    void run() {
+#ifndef _WIN32
+        pollfd fds[MAX_CLIENTS + 1];
+        PendingRequest pending[MAX_CLIENTS];
+        bool backlog = false;   // some client still has bytes after its last request
+
+        while (!stopping.load()) {
+            fds[0].fd = listenFd;
+            fds[0].events = POLLIN;
+            for (int i = 0; i < clientCount; i++) {
+                fds[i + 1].fd = clientFds[i];
+                fds[i + 1].events = POLLIN;
+                fds[i + 1].revents = 0;
+            }
+
+            // Short timeout so stop() is noticed promptly; none when a buffered
+            // request may already be waiting
+            int ready = poll(fds, clientCount + 1, backlog ? 0 : 100);
+            if (ready < 0 || (ready == 0 && !backlog)) {
+                continue;
+            }
+
+            // Collect at most one complete request per client, then answer them together
+            int pendingCount = 0;
+            int polledClients = clientCount;
+            bool dead[MAX_CLIENTS] = {false};
+            backlog = false;
+            for (int i = 0; i < polledClients; i++) {
+                if ((fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) && !receive(i)) {
+                    dead[i] = true;
+                    continue;
+                }
+                std::string& inbox = clientInboxes[i];
+                if (inbox.empty()) {
+                    dead[i] = clientEnded[i];
+                    continue;
+                }
+
+                // A client that has ended is closed once its last whole request
+                // is answered (dead clients are closed after answerBatch)
+                pending[pendingCount].client = i;
+                long used = parseRequest(inbox, pending[pendingCount]);
+                if (used < 0 || (used == 0 && (clientEnded[i] || inbox.size() >= QueryProtocol::MAX_REQUEST_BYTES))) {
+                    dead[i] = true;
+                } else if (used > 0) {
+                    inbox.erase(0, static_cast<size_t>(used));
+                    backlog = backlog || !inbox.empty();
+                    dead[i] = clientEnded[i] && inbox.empty();
+                    pendingCount++;
+                }
+            }
+
+            if (pendingCount > 0) {
+                answerBatch(pending, pendingCount, dead);
+            }
+
+            // Highest slot first: closeClient moves the last client into the freed slot
+            for (int i = polledClients - 1; i >= 0; i--) {
+                if (dead[i]) closeClient(i);
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listenFd, NULL, NULL);
+                if (fd >= 0) {
+                    int flags = fcntl(fd, F_GETFL, 0);
+                    if (clientCount < MAX_CLIENTS && flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0) {
+                        clientEnded[clientCount] = false;
+                        clientFds[clientCount++] = fd;
+                    } else {
+                        close(fd);
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    void stop() {
+        stopping.store(true);
+    }
+
+    void shutdown() {
+#ifndef _WIN32
+        while (clientCount > 0) {
+            closeClient(clientCount - 1);
+        }
+        if (listenFd >= 0) {
+            close(listenFd);
+            listenFd = -1;
+            unlink(socketPath.c_str());
+        }
+#endif
+    }
+
+    long long getRequestsServed() const { return requestsServed; }
+    long long getBatchesServed() const { return batchesServed; }
+    int getLargestBatch() const { return largestBatch; }
+};
+
+// Blocking client for the protocol above, used by the load generator
+class JobQueryClient {
+private:
+    int fd;
+
+public:
+    JobQueryClient() : fd(-1) {}
+
+    ~JobQueryClient() {
+        disconnect();
+    }
+
+    bool connectTo(const std::string& path) {
+#ifdef _WIN32
+        (void)path;
+        return false;
+#else
+        sockaddr_un address;
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            disconnect();
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    void disconnect() {
+#ifndef _WIN32
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+    // Returns the number of matches written to `out` (capacity >= k), or -1 on error
+    int queryByIndex(int jobIndex, int k, ScoredIndex* out) {
+#ifdef _WIN32
+        (void)jobIndex;
+        (void)k;
+        (void)out;
+        return -1;
+#else
+        uint32_t status;
+        int count = 0;
+        if (!Wire::writeU32(fd, static_cast<uint32_t>(k)) ||
+            !Wire::writeU32(fd, QueryProtocol::BY_INDEX) ||
+            !Wire::writeU32(fd, static_cast<uint32_t>(jobIndex)) ||
+            !Wire::readU32(fd, status) ||
+            !Wire::readMatches(fd, out, k, count) ||
+            status != QueryProtocol::STATUS_OK) {
+            return -1;
+        }
+        return count;
+#endif
+    }
+};
+
+// Starts a server on `path` in a background thread, drives it with `clients`
+// concurrent connections issuing `requestsPerClient` queries each, and reports
+// throughput plus how many requests each scan answered on average.
+inline void runServerLoadTest(JobMatchingSystem& system, const std::string& path,
+                              int clients, int requestsPerClient, int k) {
+    std::cout << "\n=== Query Server Load Test ===" << std::endl;
+    if (system.getJobCount() == 0 || system.getResumeCount() == 0) {
+        std::cout << "Error: No data loaded for load test" << std::endl;
+        return;
+    }
+
+    JobQueryServer server(system);
+    if (!server.listenOn(path)) {
+        return;
+    }
+    std::thread serverThread([&server]() { server.run(); });
+
+    std::atomic<long long> completed(0);
+    std::atomic<long long> failed(0);
+    std::thread* workers = new std::thread[clients];
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int c = 0; c < clients; c++) {
+        workers[c] = std::thread([&, c]() {
+            JobQueryClient client;
+            if (!client.connectTo(path)) {
+                failed += requestsPerClient;
+                return;
+            }
+            ScoredIndex* matches = new ScoredIndex[k];
+            unsigned int seed = 2654435761u * (c + 1);
+            for (int r = 0; r < requestsPerClient; r++) {
+                seed = seed * 1103515245u + 12345u;
+                int jobIndex = static_cast<int>((seed >> 8) % system.getJobCount());
+                if (client.queryByIndex(jobIndex, k, matches) >= 0) {
+                    completed++;
+                } else {
+                    failed++;
+                }
+            }
+            delete[] matches;
+        });
+    }
+    for (int c = 0; c < clients; c++) {
+        workers[c].join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    delete[] workers;
+
+    server.stop();
+    serverThread.join();
+
+    std::cout << "Clients: " << clients << " | Requests: " << completed.load()
+              << " ok, " << failed.load() << " failed" << std::endl;
+    std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << seconds << " s | Throughput: "
+              << std::setprecision(1) << (seconds > 0 ? completed.load() / seconds : 0.0)
+              << " requests/s" << std::endl;
+    std::cout << "Scans: " << server.getBatchesServed() << " | Avg requests per scan: "
+              << std::setprecision(2)
+              << (server.getBatchesServed() > 0
+                      ? double(server.getRequestsServed()) / server.getBatchesServed() : 0.0)
+              << " | Largest batch: " << server.getLargestBatch() << std::endl;
+}
+
+#endif
@@ -0,0 +1,597 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// Compressed set of 32-bit document ids in the style of Roaring bitmaps.
+// Ids are split by their high 16 bits into containers of up to 65536 values,
+// and every container picks the smallest of three layouts:
+//   ARRAY   sorted uint16 values          (sparse, up to 4096 values)
+//   BITMAP  1024 x 64-bit words           (dense)
+//   RUN     (start, length - 1) pairs     (long consecutive stretches)
+// AND / OR / ANDNOT work container by container; cardinality is kept per
+// container so it is O(containers).
+class RoaringBitmap {
+public:
+    static const int ARRAY_LIMIT = 4096;
+    static const int BITMAP_WORDS = 1024;
+
+private:
+    enum ContainerType { ARRAY, BITMAP, RUN };
+
+    struct Container {
+        uint16_t key;
+        uint8_t type;
+        int cardinality;
+        int size;            // ARRAY: number of values, RUN: number of runs
+        int capacity;        // uint16 slots allocated in `values`
+        uint16_t* values;    // ARRAY values, or RUN pairs
+        uint64_t* words;     // BITMAP words
+    };
+
+    Container* containers;
+    int count;
+    int capacity;
+
+    // ---- container helpers -------------------------------------------------
+
+    static Container emptyContainer(uint16_t key) {
+        Container c;
+        c.key = key;
+        c.type = ARRAY;
+        c.cardinality = 0;
+        c.size = 0;
+        c.capacity = 0;
+        c.values = NULL;
+        c.words = NULL;
+        return c;
+    }
+
+    static void freeContainer(Container& c) {
+        delete[] c.values;
+        delete[] c.words;
+        c.values = NULL;
+        c.words = NULL;
+    }
+
+    static Container copyContainer(const Container& source) {
+        Container c = source;
+        if (source.values) {
+            c.values = new uint16_t[source.capacity];
+            std::memcpy(c.values, source.values, sizeof(uint16_t) * source.capacity);
+        }
+        if (source.words) {
+            c.words = new uint64_t[BITMAP_WORDS];
+            std::memcpy(c.words, source.words, sizeof(uint64_t) * BITMAP_WORDS);
+        }
+        return c;
+    }
+
+    static void setRange(uint64_t* words, int first, int last) {
+        for (int value = first; value <= last;) {
+            int word = value >> 6;
+            int bit = value & 63;
+            int span = std::min(64 - bit, last - value + 1);
+            uint64_t mask = (span == 64) ? ~0ull : (((1ull << span) - 1) << bit);
+            words[word] |= mask;
+            value += span;
+        }
+    }
+
+    // Any container as 1024 words; BITMAP containers are returned without copying
+    static const uint64_t* asWords(const Container& c, uint64_t* scratch) {
+        if (c.type == BITMAP) return c.words;
+        std::memset(scratch, 0, sizeof(uint64_t) * BITMAP_WORDS);
+        if (c.type == ARRAY) {
+            for (int i = 0; i < c.size; i++) {
+                scratch[c.values[i] >> 6] |= 1ull << (c.values[i] & 63);
+            }
+        } else {
+            for (int r = 0; r < c.size; r++) {
+                setRange(scratch, c.values[2 * r], c.values[2 * r] + c.values[2 * r + 1]);
+            }
+        }
+        return scratch;
+    }
+
+    static bool wordsContain(const uint64_t* words, uint16_t value) {
+        return (words[value >> 6] >> (value & 63)) & 1;
+    }
+
+    static Container makeArray(uint16_t key, const uint16_t* values, int n) {
+        Container c = emptyContainer(key);
+        c.capacity = n > 0 ? n : 1;
+        c.values = new uint16_t[c.capacity];
+        std::memcpy(c.values, values, sizeof(uint16_t) * n);
+        c.size = n;
+        c.cardinality = n;
+        return c;
+    }
+
+    // Smallest of ARRAY / BITMAP for a word image
+    static Container fromWords(uint16_t key, const uint64_t* words) {
+        int cardinality = 0;
+        for (int i = 0; i < BITMAP_WORDS; i++) cardinality += __builtin_popcountll(words[i]);
+
+        Container c = emptyContainer(key);
+        c.cardinality = cardinality;
+        if (cardinality > ARRAY_LIMIT) {
+            c.type = BITMAP;
+            c.words = new uint64_t[BITMAP_WORDS];
+            std::memcpy(c.words, words, sizeof(uint64_t) * BITMAP_WORDS);
+            return c;
+        }
+
+        c.capacity = cardinality > 0 ? cardinality : 1;
+        c.values = new uint16_t[c.capacity];
+        for (int i = 0; i < BITMAP_WORDS; i++) {
+            for (uint64_t w = words[i]; w; w &= w - 1) {
+                c.values[c.size++] = static_cast<uint16_t>(i * 64 + __builtin_ctzll(w));
+            }
+        }
+        return c;
+    }
+
+    static void convertToWords(Container& c) {
+        uint64_t scratch[BITMAP_WORDS];
+        const uint64_t* words = asWords(c, scratch);
+        Container converted = fromWords(c.key, words);
+        if (converted.type != BITMAP) {
+            // Keep a bitmap while values are being added, whatever the count
+            freeContainer(converted);
+            converted = emptyContainer(c.key);
+            converted.type = BITMAP;
+            converted.words = new uint64_t[BITMAP_WORDS];
+            std::memcpy(converted.words, words, sizeof(uint64_t) * BITMAP_WORDS);
+            converted.cardinality = c.cardinality;
+        }
+        freeContainer(c);
+        c = converted;
+    }
+
+    static void addToContainer(Container& c, uint16_t value) {
+        if (c.type == RUN) {
+            convertToWords(c);
+        }
+        if (c.type == BITMAP) {
+            uint64_t bit = 1ull << (value & 63);
+            if (!(c.words[value >> 6] & bit)) {
+                c.words[value >> 6] |= bit;
+                c.cardinality++;
+            }
+            return;
+        }
+
+        // ARRAY: appends (the common case when loading in id order) are O(1)
+        int position = c.size;
+        if (c.size > 0 && c.values[c.size - 1] >= value) {
+            position = static_cast<int>(std::lower_bound(c.values, c.values + c.size, value) - c.values);
+            if (c.values[position] == value) return;
+        }
+        if (c.size == ARRAY_LIMIT) {
+            convertToWords(c);
+            addToContainer(c, value);
+            return;
+        }
+        if (c.size == c.capacity) {
+            int newCapacity = c.capacity < 4 ? 4 : c.capacity * 2;
+            if (newCapacity > ARRAY_LIMIT) newCapacity = ARRAY_LIMIT;
+            uint16_t* grown = new uint16_t[newCapacity];
+            if (c.size > 0) std::memcpy(grown, c.values, sizeof(uint16_t) * c.size);
+            delete[] c.values;
+            c.values = grown;
+            c.capacity = newCapacity;
+        }
+        std::memmove(c.values + position + 1, c.values + position, sizeof(uint16_t) * (c.size - position));
+        c.values[position] = value;
+        c.size++;
+        c.cardinality++;
+    }
+
+    static bool containerContains(const Container& c, uint16_t value) {
+        if (c.type == BITMAP) return wordsContain(c.words, value);
+        if (c.type == ARRAY) return std::binary_search(c.values, c.values + c.size, value);
+        // RUN: last run starting at or before value
+        int lo = 0, hi = c.size - 1, found = -1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (c.values[2 * mid] <= value) { found = mid; lo = mid + 1; }
+            else hi = mid - 1;
+        }
+        return found >= 0 && value <= c.values[2 * found] + c.values[2 * found + 1];
+    }
+
+    static int countRuns(const Container& c) {
+        if (c.type == RUN) return c.size;
+        if (c.type == ARRAY) {
+            int runs = c.size > 0 ? 1 : 0;
+            for (int i = 1; i < c.size; i++) {
+                if (c.values[i] != c.values[i - 1] + 1) runs++;
+            }
+            return runs;
+        }
+        int runs = 0;
+        uint64_t carry = 0;
+        for (int i = 0; i < BITMAP_WORDS; i++) {
+            uint64_t w = c.words[i];
+            runs += __builtin_popcountll(w & ~((w << 1) | carry));
+            carry = w >> 63;
+        }
+        return runs;
+    }
+
+    // Payload bytes of a container in its current layout, ignoring slack
+    static int containerBytes(const Container& c) {
+        if (c.type == BITMAP) return BITMAP_WORDS * 8;
+        if (c.type == RUN) return c.size * 4;
+        return c.size * 2;
+    }
+
+    static void convertToRuns(Container& c, int runs) {
+        uint16_t* pairs = new uint16_t[2 * runs > 0 ? 2 * runs : 1];
+        int size = 0;
+        int start = -1, previous = -2;
+        auto emit = [&](int value) {
+            if (value != previous + 1) {
+                if (start >= 0) {
+                    pairs[2 * size] = static_cast<uint16_t>(start);
+                    pairs[2 * size + 1] = static_cast<uint16_t>(previous - start);
+                    size++;
+                }
+                start = value;
+            }
+            previous = value;
+        };
+        if (c.type == ARRAY) {
+            for (int i = 0; i < c.size; i++) emit(c.values[i]);
+        } else {
+            for (int i = 0; i < BITMAP_WORDS; i++) {
+                for (uint64_t w = c.words[i]; w; w &= w - 1) emit(i * 64 + __builtin_ctzll(w));
+            }
+        }
+        if (start >= 0) {
+            pairs[2 * size] = static_cast<uint16_t>(start);
+            pairs[2 * size + 1] = static_cast<uint16_t>(previous - start);
+            size++;
+        }
+
+        int cardinality = c.cardinality;
+        uint16_t key = c.key;
+        freeContainer(c);
+        c = emptyContainer(key);
+        c.type = RUN;
+        c.values = pairs;
+        c.size = size;
+        c.capacity = 2 * runs > 0 ? 2 * runs : 1;
+        c.cardinality = cardinality;
+    }
+
+    // ---- pairwise container operations --------------------------------------
+
+    static int gallop(const uint16_t* values, int size, int from, uint16_t target) {
+        int step = 1;
+        int hi = from;
+        while (hi < size && values[hi] < target) {
+            from = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        return static_cast<int>(std::lower_bound(values + from, values + std::min(hi, size), target) - values);
+    }
+
+    static Container andContainers(const Container& a, const Container& b) {
+        uint16_t buffer[ARRAY_LIMIT];
+        uint64_t scratchA[BITMAP_WORDS], scratchB[BITMAP_WORDS];
+
+        if (a.type == ARRAY && b.type == ARRAY) {
+            // Smaller side drives, galloping through the larger one
+            const Container& small = a.size <= b.size ? a : b;
+            const Container& large = a.size <= b.size ? b : a;
+            int n = 0, j = 0;
+            for (int i = 0; i < small.size && j < large.size; i++) {
+                j = gallop(large.values, large.size, j, small.values[i]);
+                if (j < large.size && large.values[j] == small.values[i]) buffer[n++] = small.values[i];
+            }
+            return makeArray(a.key, buffer, n);
+        }
+        if (a.type == ARRAY || b.type == ARRAY) {
+            const Container& array = a.type == ARRAY ? a : b;
+            const uint64_t* words = asWords(a.type == ARRAY ? b : a, scratchB);
+            int n = 0;
+            for (int i = 0; i < array.size; i++) {
+                if (wordsContain(words, array.values[i])) buffer[n++] = array.values[i];
+            }
+            return makeArray(a.key, buffer, n);
+        }
+        const uint64_t* wa = asWords(a, scratchA);
+        const uint64_t* wb = asWords(b, scratchB);
+        uint64_t result[BITMAP_WORDS];
+        for (int i = 0; i < BITMAP_WORDS; i++) result[i] = wa[i] & wb[i];
+        return fromWords(a.key, result);
+    }
+
+    static Container orContainers(const Container& a, const Container& b) {
+        uint64_t scratchA[BITMAP_WORDS], scratchB[BITMAP_WORDS];
+        if (a.type == ARRAY && b.type == ARRAY && a.size + b.size <= ARRAY_LIMIT) {
+            uint16_t buffer[ARRAY_LIMIT];
+            int n = static_cast<int>(std::set_union(a.values, a.values + a.size,
+                                                    b.values, b.values + b.size, buffer) - buffer);
+            return makeArray(a.key, buffer, n);
+        }
+        const uint64_t* wa = asWords(a, scratchA);
+        const uint64_t* wb = asWords(b, scratchB);
+        uint64_t result[BITMAP_WORDS];
+        for (int i = 0; i < BITMAP_WORDS; i++) result[i] = wa[i] | wb[i];
+        return fromWords(a.key, result);
+    }
+
+    static Container andNotContainers(const Container& a, const Container& b) {
+        uint64_t scratchA[BITMAP_WORDS], scratchB[BITMAP_WORDS];
+        if (a.type == ARRAY) {
+            uint16_t buffer[ARRAY_LIMIT];
+            int n = 0;
+            if (b.type == ARRAY) {
+                int j = 0;
+                for (int i = 0; i < a.size; i++) {
+                    j = gallop(b.values, b.size, j, a.values[i]);
+                    if (j >= b.size || b.values[j] != a.values[i]) buffer[n++] = a.values[i];
+                }
+            } else {
+                const uint64_t* words = asWords(b, scratchB);
+                for (int i = 0; i < a.size; i++) {
+                    if (!wordsContain(words, a.values[i])) buffer[n++] = a.values[i];
+                }
+            }
+            return makeArray(a.key, buffer, n);
+        }
+        const uint64_t* wa = asWords(a, scratchA);
+        const uint64_t* wb = asWords(b, scratchB);
+        uint64_t result[BITMAP_WORDS];
+        for (int i = 0; i < BITMAP_WORDS; i++) result[i] = wa[i] & ~wb[i];
+        return fromWords(a.key, result);
+    }
+
+    // ---- container list ----------------------------------------------------
+
+    void reserve(int needed) {
+        if (needed <= capacity) return;
+        int newCapacity = capacity < 4 ? 4 : capacity;
+        while (newCapacity < needed) newCapacity *= 2;
+        Container* grown = new Container[newCapacity];
+        for (int i = 0; i < count; i++) grown[i] = containers[i];
+        delete[] containers;
+        containers = grown;
+        capacity = newCapacity;
+    }
+
+    // Takes ownership of `c`; containers must arrive in increasing key order
+    void appendContainer(const Container& c) {
+        if (c.cardinality == 0) {
+            Container empty = c;
+            freeContainer(empty);
+            return;
+        }
+        reserve(count + 1);
+        containers[count++] = c;
+    }
+
+    int findContainer(uint16_t key) const {
+        if (count > 0 && containers[count - 1].key == key) return count - 1;
+        int lo = 0, hi = count - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (containers[mid].key == key) return mid;
+            if (containers[mid].key < key) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -(lo + 1);
+    }
+
+    void releaseAll() {
+        for (int i = 0; i < count; i++) freeContainer(containers[i]);
+        delete[] containers;
+        containers = NULL;
+        count = 0;
+        capacity = 0;
+    }
+
+public:
+    RoaringBitmap() : containers(NULL), count(0), capacity(0) {}
+
+    RoaringBitmap(const RoaringBitmap& other) : containers(NULL), count(0), capacity(0) {
+        reserve(other.count);
+        for (int i = 0; i < other.count; i++) containers[i] = copyContainer(other.containers[i]);
+        count = other.count;
+    }
+
+    RoaringBitmap(RoaringBitmap&& other) : containers(other.containers), count(other.count), capacity(other.capacity) {
+        other.containers = NULL;
+        other.count = 0;
+        other.capacity = 0;
+    }
+
+    RoaringBitmap& operator=(const RoaringBitmap& other) {
+        if (this != &other) {
+            RoaringBitmap copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    RoaringBitmap& operator=(RoaringBitmap&& other) {
+        if (this != &other) {
+            releaseAll();
+            containers = other.containers;
+            count = other.count;
+            capacity = other.capacity;
+            other.containers = NULL;
+            other.count = 0;
+            other.capacity = 0;
+        }
+        return *this;
+    }
+
+    ~RoaringBitmap() {
+        releaseAll();
+    }
+
+    void add(uint32_t value) {
+        uint16_t key = static_cast<uint16_t>(value >> 16);
+        int index = findContainer(key);
+        if (index < 0) {
+            index = -index - 1;
+            reserve(count + 1);
+            for (int i = count; i > index; i--) containers[i] = containers[i - 1];
+            containers[index] = emptyContainer(key);
+            count++;
+        }
+        addToContainer(containers[index], static_cast<uint16_t>(value & 0xFFFF));
+    }
+
+    // Adds [begin, end) as run containers
+    void addRange(uint32_t begin, uint32_t end) {
+        while (begin < end) {
+            uint16_t key = static_cast<uint16_t>(begin >> 16);
+            uint32_t containerEnd = std::min<uint32_t>(end, (static_cast<uint32_t>(key) + 1) << 16);
+            if (findContainer(key) >= 0) {
+                for (uint32_t v = begin; v < containerEnd; v++) add(v);
+            } else {
+                Container c = emptyContainer(key);
+                c.type = RUN;
+                c.capacity = 2;
+                c.values = new uint16_t[2];
+                c.values[0] = static_cast<uint16_t>(begin & 0xFFFF);
+                c.values[1] = static_cast<uint16_t>(containerEnd - begin - 1);
+                c.size = 1;
+                c.cardinality = static_cast<int>(containerEnd - begin);
+                int index = -findContainer(key) - 1;
+                reserve(count + 1);
+                for (int i = count; i > index; i--) containers[i] = containers[i - 1];
+                containers[index] = c;
+                count++;
+            }
+            begin = containerEnd;
+        }
+    }
+
+    bool contains(uint32_t value) const {
+        int index = findContainer(static_cast<uint16_t>(value >> 16));
+        return index >= 0 && containerContains(containers[index], static_cast<uint16_t>(value & 0xFFFF));
+    }
+
+    long long cardinality() const {
+        long long total = 0;
+        for (int i = 0; i < count; i++) total += containers[i].cardinality;
+        return total;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Switches every container to RUN where that is the smallest layout, and
+    // trims array slack. Call once a bitmap is fully built.
+    void runOptimize() {
+        for (int i = 0; i < count; i++) {
+            Container& c = containers[i];
+            int runs = countRuns(c);
+            if (c.type != RUN && runs * 4 < containerBytes(c)) {
+                convertToRuns(c, runs);
+            } else if (c.type == ARRAY && c.capacity > c.size) {
+                Container trimmed = makeArray(c.key, c.values, c.size);
+                freeContainer(c);
+                c = trimmed;
+            }
+        }
+    }
+
+    // Approximate heap footprint of the containers
+    long long memoryBytes() const {
+        long long total = static_cast<long long>(capacity) * sizeof(Container);
+        for (int i = 0; i < count; i++) {
+            const Container& c = containers[i];
+            total += c.type == BITMAP ? BITMAP_WORDS * 8 : c.capacity * 2;
+        }
+        return total;
+    }
+
+    // Calls visit(value) for every value in increasing order
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (int i = 0; i < count; i++) {
+            const Container& c = containers[i];
+            uint32_t high = static_cast<uint32_t>(c.key) << 16;
+            if (c.type == ARRAY) {
+                for (int j = 0; j < c.size; j++) visit(high | c.values[j]);
+            } else if (c.type == BITMAP) {
+                for (int w = 0; w < BITMAP_WORDS; w++) {
+                    for (uint64_t bits = c.words[w]; bits; bits &= bits - 1) {
+                        visit(high | static_cast<uint32_t>(w * 64 + __builtin_ctzll(bits)));
+                    }
+                }
+            } else {
+                for (int r = 0; r < c.size; r++) {
+                    uint32_t first = c.values[2 * r];
+                    uint32_t last = first + c.values[2 * r + 1];
+                    for (uint32_t v = first; v <= last; v++) visit(high | v);
+                }
+            }
+        }
+    }
+
+    // Writes the values in increasing order; `out` must hold cardinality() ints
+    int toArray(int* out) const {
+        int n = 0;
+        forEach([&](uint32_t value) { out[n++] = static_cast<int>(value); });
+        return n;
+    }
+
+    void clear() {
+        releaseAll();
+    }
+
+    static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        int i = 0, j = 0;
+        while (i < a.count && j < b.count) {
+            if (a.containers[i].key < b.containers[j].key) i++;
+            else if (b.containers[j].key < a.containers[i].key) j++;
+            else result.appendContainer(andContainers(a.containers[i++], b.containers[j++]));
+        }
+        return result;
+    }
+
+    static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        int i = 0, j = 0;
+        while (i < a.count || j < b.count) {
+            if (j >= b.count || (i < a.count && a.containers[i].key < b.containers[j].key)) {
+                result.appendContainer(copyContainer(a.containers[i++]));
+            } else if (i >= a.count || b.containers[j].key < a.containers[i].key) {
+                result.appendContainer(copyContainer(b.containers[j++]));
+            } else {
+                result.appendContainer(orContainers(a.containers[i++], b.containers[j++]));
+            }
+        }
+        return result;
+    }
+
+    // a \ b
+    static RoaringBitmap subtract(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        int j = 0;
+        for (int i = 0; i < a.count; i++) {
+            while (j < b.count && b.containers[j].key < a.containers[i].key) j++;
+            if (j < b.count && b.containers[j].key == a.containers[i].key) {
+                result.appendContainer(andNotContainers(a.containers[i], b.containers[j]));
+            } else {
+                result.appendContainer(copyContainer(a.containers[i]));
+            }
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef SHARDED_MATCHER_H
+#define SHARDED_MATCHER_H
+
+#include <iostream>
+#include <string>
+#include "JobMatchingArray.h"
+#include "TopK.h"
+#include "Wire.h"
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <signal.h>
+#endif
+
+// Splits the resume corpus across N worker processes. Each worker loads only
+// the rows of its shard (row % N == shard) and answers top-K queries over a
+// socketpair; the coordinator fans a job out to every shard and merges the
+// partial lists with the global (score desc, index asc) order.
+//
+// Request: [u32 k][string jobText]
+// Reply:   [u32 status][u32 count][count x ScoredIndex]   status 0 = ok, 1 = shard not loaded
+class ShardedJobMatcher {
+private:
+    static const uint32_t STATUS_OK = 0;
+    static const uint32_t STATUS_NOT_LOADED = 1;
+
+    struct Shard {
+        int fd;
+        int pid;
+    };
+
+    Shard* shards;
+    int shardCount;
+    std::string resumeFile;
+
+#ifndef _WIN32
+    // Worker side: serve requests until the coordinator closes the socket.
+    // A worker that could not load its rows says so in every reply rather than
+    // answering with an empty shard.
+    static void serveShard(int fd, const std::string& filename, int shard, int count) {
+        JobMatchingSystem system;
+        system.setQuietLoading(true);
+        bool loaded = system.loadResumesFromCSV(filename, shard, count);
+
+        uint32_t k;
+        std::string jobText;
+        while (Wire::readU32(fd, k) && Wire::readString(fd, jobText)) {
+            ScoredIndex* matches = new ScoredIndex[k > 0 ? k : 1];
+            int found = loaded ? system.topMatchesForJobText(jobText, static_cast<int>(k), matches) : 0;
+            for (int i = 0; i < found; i++) {
+                matches[i].index = matches[i].index * count + shard;
+            }
+            bool ok = Wire::writeU32(fd, loaded ? STATUS_OK : STATUS_NOT_LOADED) &&
+                      Wire::writeMatches(fd, matches, found);
+            delete[] matches;
+            if (!ok) break;
+        }
+    }
+
+    bool spawnShard(int shard) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            std::cout << "Error: cannot create socket for shard " << shard << std::endl;
+            return false;
+        }
+
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            std::cout << "Error: cannot start worker for shard " << shard << std::endl;
+            return false;
+        }
+
+        if (pid == 0) {
+            // Drop the coordinator's end of every other shard before serving
+            close(fds[0]);
+            for (int i = 0; i < shardCount; i++) {
+                if (shards[i].fd >= 0) close(shards[i].fd);
+            }
+            serveShard(fds[1], resumeFile, shard, shardCount);
+            close(fds[1]);
+            _exit(0);
+        }
+
+        close(fds[1]);
+        shards[shard].fd = fds[0];
+        shards[shard].pid = static_cast<int>(pid);
+        return true;
+    }
+
+    void stopShard(int shard) {
+        if (shards[shard].fd >= 0) {
+            close(shards[shard].fd);
+            shards[shard].fd = -1;
+        }
+        if (shards[shard].pid > 0) {
+            waitpid(shards[shard].pid, NULL, 0);
+            shards[shard].pid = -1;
+        }
+    }
+
+    bool sendQuery(int shard, const std::string& jobText, int k) {
+        return shards[shard].fd >= 0 &&
+               Wire::writeU32(shards[shard].fd, static_cast<uint32_t>(k)) &&
+               Wire::writeString(shards[shard].fd, jobText);
+    }
+
+    bool readReply(int shard, ScoredIndex* out, int k, int& found, uint32_t& status) {
+        return Wire::readU32(shards[shard].fd, status) &&
+               Wire::readMatches(shards[shard].fd, out, k, found);
+    }
+#endif
+
+public:
+    ShardedJobMatcher() : shards(NULL), shardCount(0) {}
+
+    ~ShardedJobMatcher() {
+        stop();
+    }
+
+    bool isRunning() const {
+        return shardCount > 0;
+    }
+
+    int getShardCount() const {
+        return shardCount;
+    }
+
+    bool start(const std::string& filename, int count) {
+#ifdef _WIN32
+        (void)filename;
+        (void)count;
+        std::cout << "Error: sharded matching needs fork() and Unix sockets" << std::endl;
+        return false;
+#else
+        stop();
+        if (count < 1) {
+            std::cout << "Error: shard count must be at least 1" << std::endl;
+            return false;
+        }
+
+        resumeFile = filename;
+        shardCount = count;
+        shards = new Shard[shardCount];
+        for (int i = 0; i < shardCount; i++) {
+            shards[i].fd = -1;
+            shards[i].pid = -1;
+        }
+        for (int i = 0; i < shardCount; i++) {
+            if (!spawnShard(i)) {
+                stop();
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+
+    void stop() {
+#ifndef _WIN32
+        for (int i = 0; i < shardCount; i++) {
+            stopShard(i);
+        }
+#endif
+        delete[] shards;
+        shards = NULL;
+        shardCount = 0;
+    }
+
+    // Best `k` resumes over all shards, in ranking order. A shard whose worker
+    // has died is restarted and asked again once before the query fails.
+    int findTopMatches(const std::string& jobText, int k, ScoredIndex* out) {
+#ifdef _WIN32
+        (void)jobText;
+        (void)k;
+        (void)out;
+        return -1;
+#else
+        if (!isRunning() || k <= 0) {
+            return 0;
+        }
+
+        // Scatter first so all shards score in parallel
+        bool* sent = new bool[shardCount];
+        for (int i = 0; i < shardCount; i++) {
+            sent[i] = sendQuery(i, jobText, k);
+        }
+
+        // Gather: each shard reply is already sorted, so a K-way merge through
+        // the heap keeps only the global best K
+        TopKHeap merged(k);
+        ScoredIndex* partial = new ScoredIndex[k];
+        bool failed = false;
+        for (int i = 0; i < shardCount; i++) {
+            int found = 0;
+            uint32_t status = STATUS_OK;
+            bool ok = sent[i] && readReply(i, partial, k, found, status);
+            if (!ok) {
+                std::cout << "Shard " << i << " did not answer, restarting worker..." << std::endl;
+                stopShard(i);
+                ok = spawnShard(i) && sendQuery(i, jobText, k) && readReply(i, partial, k, found, status);
+            }
+            if (ok && status != STATUS_OK) {
+                // Restarting would not help: the worker reads the same file
+                std::cout << "Error: shard " << i << " could not load " << resumeFile << std::endl;
+                ok = false;
+            }
+            if (!ok) {
+                failed = true;
+                continue;
+            }
+            for (int j = 0; j < found; j++) {
+                merged.offer(partial[j].index, partial[j].score);
+            }
+        }
+
+        delete[] partial;
+        delete[] sent;
+        return failed ? -1 : merged.sorted(out);
+#endif
+    }
+};
+
+#endif
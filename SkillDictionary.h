@@ -0,0 +1,336 @@
+#ifndef SKILL_DICTIONARY_H
+#define SKILL_DICTIONARY_H
+
+#include <string>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include "BatchScorer.h"
+
+// The array program's skill taxonomy: skills with a category and weight, their
+// synonyms, and the bit each distinct skill gets in a 64-bit skill mask.
+// Matches are whole words in the lowercased text. Used by JobMatchingSystem
+// and by MatchingEngine's CategorySkillDictionary.
+class SkillDictionary {
+private:
+    struct SkillCategory {
+        std::string skill;
+        std::string category;
+        double weight;
+    };
+    
+    SkillCategory skillCategories[100] = {
+        // Data Analyst Skills
+        {"sql", "data", 1.5},
+        {"excel", "data", 1.3},
+        {"power bi", "data", 1.4},
+        {"tableau", "data", 1.4},
+        {"data cleaning", "data", 1.2},
+        {"data analysis", "data", 1.3},
+        {"reporting", "data", 1.1},
+        {"statistics", "data", 1.2},
+        {"data visualization", "data", 1.3},
+        {"dashboards", "data", 1.1},
+        
+        // Data Scientist Skills
+        {"python", "data_science", 1.6},
+        {"machine learning", "data_science", 2.0},
+        {"deep learning", "data_science", 2.0},
+        {"nlp", "data_science", 1.8},
+        {"pandas", "data_science", 1.5},
+        {"numpy", "data_science", 1.4},
+        {"tensorflow", "data_science", 1.8},
+        {"pytorch", "data_science", 1.8},
+        {"keras", "data_science", 1.7},
+        {"scikit-learn", "data_science", 1.6},
+        
+        // Software Engineering Skills
+        {"java", "engineering", 1.5},
+        {"spring boot", "engineering", 1.6},
+        {"docker", "engineering", 1.4},
+        {"kubernetes", "engineering", 1.5},
+        {"rest apis", "engineering", 1.3},
+        {"microservices", "engineering", 1.4},
+        {"system design", "engineering", 1.5},
+        {"git", "engineering", 1.1},
+        {"agile", "engineering", 1.1},
+        {"ci/cd", "engineering", 1.3},
+        
+        // Machine Learning Engineer Skills
+        {"mlops", "ml_engineering", 1.6},
+        {"computer vision", "ml_engineering", 1.8},
+        {"cloud", "ml_engineering", 1.5},
+        {"model deployment", "ml_engineering", 1.4},
+        {"tensorflow serving", "ml_engineering", 1.5},
+        {"pytorch lightning", "ml_engineering", 1.5},
+        {"data pipelines", "ml_engineering", 1.3},
+
+        // Product Manager Skills
+        {"agile", "product_management", 1.3},
+        {"scrum", "product_management", 1.3},
+        {"stakeholder management", "product_management", 1.4},
+        {"user stories", "product_management", 1.3},
+        {"product roadmap", "product_management", 1.5},
+        {"requirements gathering", "product_management", 1.2},
+        {"ui/ux", "product_management", 1.1},
+        {"communication", "product_management", 1.0},
+        {"team leadership", "product_management", 1.0},
+
+        // Soft Skills
+        {"communication", "general", 1.0},
+        {"time management", "general", 1.1},
+        {"adaptability", "general", 1.0},
+        {"project management", "general", 1.1},
+        {"presentation", "general", 1.0},
+        {"leadership", "general", 1.0},
+        {"collaboration", "general", 1.0},
+        {"problem solving", "general", 1.2}
+    };
+
+    struct SkillSynonym {
+        std::string canonical;
+        std::string variants[3]; // up to 3 synonyms
+    };
+
+    SkillSynonym skillSynonyms[10] = {
+        {"rest apis", {"rest api", "restful apis", "restful api"}},
+        {"mlops", {"machine learning ops", "ml operations"}},
+        {"power bi", {"powerbi", "ms power bi"}},
+        {"git", {"version control"}},
+        {"excel", {"microsoft excel", "spreadsheets"}},
+        {"ci/cd", {"continuous integration", "continuous delivery"}}
+    };
+
+    // Compact skill encoding (see BatchScorer.h)
+    std::string skillNames[MAX_ENCODED_SKILLS];
+    double skillWeights[MAX_ENCODED_SKILLS];
+    int skillNameCount = 0;
+    int categorySkillIds[100];
+    int synonymSkillIds[10];
+    uint64_t namedSkillMask = 0;     // every skill id except the blank table entries
+
+    // Category taxonomy of skillCategories, one bit per distinct category
+    static const int MAX_CATEGORIES = 8;
+    std::string categoryNames[MAX_CATEGORIES];
+    int categoryCount = 0;
+    uint8_t skillCategoryBits[MAX_ENCODED_SKILLS];
+    uint8_t generalCategoryBit = 0;
+
+    static bool isValidSkillMatch(const std::string& text, const std::string& skill) {
+        // Prevent partial matches like "ai" in "wait", "hair", "again"
+        std::size_t pos = text.find(skill);
+        
+        if (pos == std::string::npos) return false;
+        
+        // Check character before the match
+        if (pos > 0 && std::isalpha(text[pos - 1])) {
+            return false; // Skill is part of a larger word
+        }
+        
+        // Check character after the match
+        std::size_t after = pos + skill.length();
+        if (after < text.length() && std::isalpha(text[after])) {
+            return false; // Skill is part of a larger word
+        }
+        
+        return true;
+    }
+
+    // Calls visit(skillId) for every skill found, in the order extractSkills reports them
+    template <typename Visit>
+    void scanSkillIds(const std::string& lowercaseText, Visit visit) const {
+        // Regular skill detection
+        for (int i = 0; i < 100; i++) {
+            const std::string& skill = skillCategories[i].skill;
+            if (lowercaseText.find(skill) != std::string::npos && isValidSkillMatch(lowercaseText, skill)) {
+                visit(categorySkillIds[i]);
+            }
+        }
+
+        // Synonym-based detection
+        for (int i = 0; i < 10; i++) {
+            for (const std::string& variant : skillSynonyms[i].variants) {
+                if (variant.empty()) break;
+                if (lowercaseText.find(variant) != std::string::npos && isValidSkillMatch(lowercaseText, variant)) {
+                    visit(synonymSkillIds[i]);
+                    break;
+                }
+            }
+        }
+    }
+
+    int addSkillName(const std::string& skill) {
+        int id = findSkillId(skill);
+        if (id >= 0) {
+            return id;
+        }
+        if (skillNameCount >= MAX_ENCODED_SKILLS) {
+            throw std::length_error("Skill dictionary exceeds the 64-bit skill mask");
+        }
+        skillNames[skillNameCount] = skill;
+        skillWeights[skillNameCount] = calculateSkillWeight(skill);
+        return skillNameCount++;
+    }
+
+    // Assigns a bit to every distinct skill of skillCategories and skillSynonyms
+    void build() {
+        skillNameCount = 0;
+        for (int i = 0; i < 100; i++) {
+            categorySkillIds[i] = addSkillName(skillCategories[i].skill);
+        }
+        for (int i = 0; i < 10; i++) {
+            synonymSkillIds[i] = addSkillName(skillSynonyms[i].canonical);
+        }
+
+        namedSkillMask = 0;
+        for (int id = 0; id < skillNameCount; id++) {
+            if (!skillNames[id].empty()) {
+                namedSkillMask |= 1ull << id;
+            }
+        }
+
+        categoryCount = 0;
+        for (int id = 0; id < MAX_ENCODED_SKILLS; id++) {
+            skillCategoryBits[id] = 0;
+        }
+        for (int i = 0; i < 100; i++) {
+            if (skillCategories[i].skill.empty()) continue;
+            int category = 0;
+            while (category < categoryCount && categoryNames[category] != skillCategories[i].category) {
+                category++;
+            }
+            if (category == categoryCount) {
+                if (categoryCount >= MAX_CATEGORIES) {
+                    throw std::length_error("Too many skill categories for the category mask");
+                }
+                categoryNames[categoryCount++] = skillCategories[i].category;
+            }
+            skillCategoryBits[categorySkillIds[i]] |= static_cast<uint8_t>(1u << category);
+            if (skillCategories[i].category == "general") {
+                generalCategoryBit = static_cast<uint8_t>(1u << category);
+            }
+        }
+    }
+
+public:
+    SkillDictionary() {
+        build();
+    }
+
+    static std::string toLowercase(const std::string& text) {
+        std::string result = text;
+        for (char& c : result) {
+            c = std::tolower(c);
+        }
+        return result;
+    }
+
+    // Calls visit(skillId) for every skill of `text`; a skill listed twice is
+    // reported twice
+    template <typename Visit>
+    void forEachSkill(const std::string& text, Visit visit) const {
+        scanSkillIds(toLowercase(text), visit);
+    }
+
+    double calculateSkillWeight(const std::string& skill) const {
+        for (int i = 0; i < 100; i++) {
+            if (skillCategories[i].skill == skill) {
+                return skillCategories[i].weight;
+            }
+        }
+        return 1.0; // Default weight for unmatched skills
+    }
+
+    // Bit mask of the distinct skills found in a resume
+    uint64_t encodeResume(const std::string& text) const {
+        uint64_t mask = 0;
+        forEachSkill(text, [&](int id) { mask |= 1ull << id; });
+        return mask;
+    }
+
+    // Distinct job skills with multiplicity, ready for the batch kernels
+    EncodedJob encodeJob(const std::string& text) const {
+        int counts[MAX_ENCODED_SKILLS] = {0};
+        forEachSkill(text, [&](int id) { counts[id]++; });
+
+        EncodedJob job;
+        for (int id = 0; id < skillNameCount; id++) {
+            job.addSkill(id, counts[id], skillWeights[id]);
+        }
+        return job;
+    }
+
+    int findSkillId(const std::string& skill) const {
+        for (int id = 0; id < skillNameCount; id++) {
+            if (skillNames[id] == skill) {
+                return id;
+            }
+        }
+        return -1;
+    }
+
+    const std::string& skillName(int id) const {
+        return skillNames[id];
+    }
+
+    uint64_t getNamedSkillMask() const {
+        return namedSkillMask;
+    }
+
+    // Sum of the weights of every skill in the dictionary
+    double getTotalSkillWeight() const {
+        double total = 0.0;
+        for (int id = 0; id < skillNameCount; id++) {
+            total += skillWeights[id];
+        }
+        return total;
+    }
+
+    // Categories of every skill in a skill mask ("agile" counts for both of its categories)
+    uint8_t categoriesOf(uint64_t skillMask) const {
+        uint8_t categories = 0;
+        for (uint64_t bits = skillMask; bits; bits &= bits - 1) {
+            categories |= skillCategoryBits[__builtin_ctzll(bits)];
+        }
+        return categories;
+    }
+
+    // Non-general categories a job query filters on
+    uint8_t jobCategories(const EncodedJob& job) const {
+        return static_cast<uint8_t>(categoriesOf(job.skillMask) & ~generalCategoryBit);
+    }
+
+    // Skills a filter term stands for: "category:<name>" is every skill of that
+    // category, anything else one skill by canonical name or synonym
+    uint64_t resolveFilterTerm(const std::string& term) const {
+        const std::string prefix = "category:";
+        if (term.compare(0, prefix.size(), prefix) == 0) {
+            std::string category = term.substr(prefix.size());
+            uint64_t mask = 0;
+            for (int i = 0; i < 100; i++) {
+                if (!skillCategories[i].skill.empty() && skillCategories[i].category == category) {
+                    mask |= 1ull << categorySkillIds[i];
+                }
+            }
+            if (mask == 0) {
+                throw std::invalid_argument("Unknown category: " + category);
+            }
+            return mask;
+        }
+
+        int id = findSkillId(term);
+        if (id >= 0 && !term.empty()) {
+            return 1ull << id;
+        }
+        for (int i = 0; i < 10; i++) {
+            for (const std::string& variant : skillSynonyms[i].variants) {
+                if (!variant.empty() && variant == term) {
+                    return 1ull << synonymSkillIds[i];
+                }
+            }
+        }
+        throw std::invalid_argument("Unknown skill: " + term);
+    }
+};
+
+#endif
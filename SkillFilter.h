@@ -0,0 +1,344 @@
+#ifndef SKILL_FILTER_H
+#define SKILL_FILTER_H
+
+#include <string>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include "SkillPostings.h"
+
+// Boolean must-have / must-not filters over canonical skills and categories:
+//
+//   expr    := andExpr ( OR andExpr )*
+//   andExpr := notExpr ( AND notExpr )*
+//   notExpr := NOT notExpr | '(' expr ')' | term
+//   term    := skill words | "quoted skill" | category:<name>
+//
+// e.g.  kubernetes AND (java OR python) AND NOT category:product_management
+//
+// Keywords are case-insensitive. A filter is compiled against the skill
+// posting bitmaps: AND intersects smallest-first, NOT becomes a set
+// difference, so cost follows the posting sizes rather than the corpus size
+// (only a filter that is negative as a whole needs the corpus).
+struct FilterNode {
+    enum Kind { TERM, AND, OR, NOT };
+
+    Kind kind;
+    std::string term;
+    FilterNode* left;
+    FilterNode* right;
+
+    FilterNode(Kind k, FilterNode* l = NULL, FilterNode* r = NULL) : kind(k), left(l), right(r) {}
+
+    ~FilterNode() {
+        delete left;
+        delete right;
+    }
+};
+
+class SkillFilterParser {
+private:
+    std::string text;
+    size_t pos;
+
+    void skipSpaces() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    // Next bare word, without consuming it
+    std::string peekWord() {
+        skipSpaces();
+        size_t end = pos;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])) &&
+               text[end] != '(' && text[end] != ')' && text[end] != '"') {
+            end++;
+        }
+        return text.substr(pos, end - pos);
+    }
+
+    bool acceptKeyword(const char* keyword) {
+        std::string word = peekWord();
+        if (word == keyword) {
+            pos += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    static bool isKeyword(const std::string& word) {
+        return word == "and" || word == "or" || word == "not";
+    }
+
+    FilterNode* parseOr() {
+        FilterNode* node = parseAnd();
+        while (acceptKeyword("or")) {
+            node = new FilterNode(FilterNode::OR, node, parseAnd());
+        }
+        return node;
+    }
+
+    FilterNode* parseAnd() {
+        FilterNode* node = parseNot();
+        while (acceptKeyword("and")) {
+            node = new FilterNode(FilterNode::AND, node, parseNot());
+        }
+        return node;
+    }
+
+    FilterNode* parseNot() {
+        if (acceptKeyword("not")) {
+            return new FilterNode(FilterNode::NOT, parseNot());
+        }
+        skipSpaces();
+        if (pos < text.size() && text[pos] == '(') {
+            pos++;
+            FilterNode* node = parseOr();
+            skipSpaces();
+            if (pos >= text.size() || text[pos] != ')') {
+                delete node;
+                throw std::invalid_argument("Missing ')' in filter");
+            }
+            pos++;
+            return node;
+        }
+        return parseTerm();
+    }
+
+    FilterNode* parseTerm() {
+        skipSpaces();
+        FilterNode* node = new FilterNode(FilterNode::TERM);
+        if (pos < text.size() && text[pos] == '"') {
+            size_t end = text.find('"', pos + 1);
+            if (end == std::string::npos) {
+                delete node;
+                throw std::invalid_argument("Unterminated quote in filter");
+            }
+            node->term = text.substr(pos + 1, end - pos - 1);
+            pos = end + 1;
+            return node;
+        }
+
+        // Multi-word skills ("machine learning") run until a keyword or parenthesis
+        std::string word = peekWord();
+        while (!word.empty() && !isKeyword(word)) {
+            if (!node->term.empty()) node->term += " ";
+            node->term += word;
+            pos += word.size();
+            word = peekWord();
+        }
+        if (node->term.empty()) {
+            delete node;
+            throw std::invalid_argument("Expected a skill or category at position " + std::to_string(pos));
+        }
+        return node;
+    }
+
+public:
+    // Throws std::invalid_argument on syntax errors; the caller owns the tree
+    FilterNode* parse(const std::string& expression) {
+        text = expression;
+        for (char& c : text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        pos = 0;
+        FilterNode* root = parseOr();
+        skipSpaces();
+        if (pos != text.size()) {
+            delete root;
+            throw std::invalid_argument("Unexpected text in filter: " + text.substr(pos));
+        }
+        return root;
+    }
+};
+
+// Document set, or its complement when `negated` is set. Either borrows a
+// skill's posting bitmap or owns the result of a set operation.
+class DocSet {
+private:
+    RoaringBitmap owned;
+    const RoaringBitmap* view;
+
+public:
+    bool negated;
+
+    DocSet() : view(&owned), negated(false) {}
+
+    explicit DocSet(const RoaringBitmap* borrowed) : view(borrowed), negated(false) {}
+
+    explicit DocSet(RoaringBitmap&& result) : owned(std::move(result)), view(&owned), negated(false) {}
+
+    DocSet(DocSet&& other)
+        : owned(std::move(other.owned)), view(other.view == &other.owned ? &owned : other.view),
+          negated(other.negated) {
+        other.view = &other.owned;
+    }
+
+    DocSet& operator=(DocSet&& other) {
+        if (this != &other) {
+            bool ownsOther = other.view == &other.owned;
+            owned = std::move(other.owned);
+            view = ownsOther ? &owned : other.view;
+            negated = other.negated;
+            other.view = &other.owned;
+        }
+        return *this;
+    }
+
+    DocSet(const DocSet&) = delete;
+    DocSet& operator=(const DocSet&) = delete;
+
+    const RoaringBitmap& bitmap() const { return *view; }
+
+    long long size() const { return view->cardinality(); }
+};
+
+namespace DocSetOps {
+
+    inline DocSet intersect(const DocSet& a, const DocSet& b) {
+        return DocSet(RoaringBitmap::intersect(a.bitmap(), b.bitmap()));
+    }
+
+    inline DocSet unite(const DocSet& a, const DocSet& b) {
+        return DocSet(RoaringBitmap::unite(a.bitmap(), b.bitmap()));
+    }
+
+    // a \ b
+    inline DocSet subtract(const DocSet& a, const DocSet& b) {
+        return DocSet(RoaringBitmap::subtract(a.bitmap(), b.bitmap()));
+    }
+
+    // [0, universe) \ a; the full range is a handful of run containers
+    inline DocSet complement(const DocSet& a, int universe) {
+        RoaringBitmap all;
+        all.addRange(0, static_cast<uint32_t>(universe));
+        return DocSet(RoaringBitmap::subtract(all, a.bitmap()));
+    }
+}
+
+// Evaluates a parsed filter. `resolve(term)` maps a term to the mask of skills
+// it stands for (one skill, or every skill of a category) and throws
+// std::invalid_argument for unknown names.
+template <typename Resolve>
+class SkillFilterEvaluator {
+private:
+    const SkillPostings& postings;
+    int universe;
+    Resolve resolve;
+
+    static void flatten(const FilterNode* node, FilterNode::Kind kind, const FilterNode** out, int& count, int capacity) {
+        if (node->kind == kind) {
+            flatten(node->left, kind, out, count, capacity);
+            flatten(node->right, kind, out, count, capacity);
+        } else if (count < capacity) {
+            out[count++] = node;
+        } else {
+            throw std::invalid_argument("Filter has too many terms");
+        }
+    }
+
+    DocSet evaluateTerm(const std::string& term) {
+        uint64_t mask = resolve(term) & postings.getIndexedSkills();
+        DocSet result;
+        bool first = true;
+        for (uint64_t bits = mask; bits; bits &= bits - 1) {
+            DocSet next(&postings.get(__builtin_ctzll(bits)));
+            result = first ? std::move(next) : DocSetOps::unite(result, next);
+            first = false;
+        }
+        return result;
+    }
+
+    // AND: positives smallest-first, then subtract the negated operands.
+    // OR:  union of positives; with negated operands it is rewritten by De Morgan.
+    DocSet evaluateChain(const FilterNode* node) {
+        const int capacity = 64;
+        const FilterNode* operands[capacity];
+        int count = 0;
+        flatten(node, node->kind, operands, count, capacity);
+
+        DocSet* sets = new DocSet[count];
+        int order[capacity];
+        int positives = 0, negatives = 0;
+        try {
+            for (int i = 0; i < count; i++) {
+                sets[i] = evaluate(operands[i]);
+            }
+        } catch (...) {
+            delete[] sets;
+            throw;
+        }
+        for (int i = 0; i < count; i++) if (!sets[i].negated) order[positives++] = i;
+        for (int i = 0; i < count; i++) if (sets[i].negated) order[positives + negatives++] = i;
+        std::sort(order, order + positives, [&](int a, int b) { return sets[a].size() < sets[b].size(); });
+        std::sort(order + positives, order + count, [&](int a, int b) { return sets[a].size() < sets[b].size(); });
+
+        DocSet result;
+        bool isAnd = node->kind == FilterNode::AND;
+        // Combine the "plain" group (positives for AND/OR) with intersection for AND
+        // and union for OR; when every operand is negated, work on the complements.
+        int firstGroup = positives > 0 ? 0 : positives;
+        int groupEnd = positives > 0 ? positives : count;
+        bool groupIntersect = (positives > 0) == isAnd;
+        result = std::move(sets[order[firstGroup]]);
+        result.negated = false;
+        for (int i = firstGroup + 1; i < groupEnd; i++) {
+            DocSet& next = sets[order[i]];
+            result = groupIntersect ? DocSetOps::intersect(result, next) : DocSetOps::unite(result, next);
+        }
+
+        if (positives > 0 && negatives > 0) {
+            if (isAnd) {
+                // A AND NOT B AND NOT C = A \ B \ C
+                for (int i = positives; i < count; i++) {
+                    result = DocSetOps::subtract(result, sets[order[i]]);
+                }
+            } else {
+                // A OR NOT B OR NOT C = NOT ((B AND C) \ A)
+                DocSet common = std::move(sets[order[positives]]);
+                common.negated = false;
+                for (int i = positives + 1; i < count; i++) {
+                    DocSet& next = sets[order[i]];
+                    common = DocSetOps::intersect(common, next);
+                }
+                result = DocSetOps::subtract(common, result);
+                result.negated = true;
+            }
+        } else if (positives == 0) {
+            // NOT B AND NOT C = NOT (B OR C);  NOT B OR NOT C = NOT (B AND C)
+            result.negated = true;
+        }
+
+        delete[] sets;
+        return result;
+    }
+
+public:
+    SkillFilterEvaluator(const SkillPostings& index, int documentCount, Resolve resolver)
+        : postings(index), universe(documentCount), resolve(resolver) {}
+
+    DocSet evaluate(const FilterNode* node) {
+        switch (node->kind) {
+            case FilterNode::TERM:
+                return evaluateTerm(node->term);
+            case FilterNode::NOT: {
+                DocSet inner = evaluate(node->left);
+                inner.negated = !inner.negated;
+                return inner;
+            }
+            default:
+                return evaluateChain(node);
+        }
+    }
+
+    // Positive result for the whole filter
+    DocSet run(const FilterNode* root) {
+        DocSet result = evaluate(root);
+        if (result.negated) {
+            return DocSetOps::complement(result, universe);
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef SKILL_POSTINGS_H
+#define SKILL_POSTINGS_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include "BatchScorer.h"
+#include "RoaringBitmap.h"
+
+// Sorted list of document indices that contain one skill
+class PostingList {
+private:
+    int* data;
+    int capacity;
+    int size;
+
+    void resize() {
+        capacity *= 2;
+        int* newData = new int[capacity];
+        std::memcpy(newData, data, sizeof(int) * size);
+        delete[] data;
+        data = newData;
+    }
+
+public:
+    PostingList() : capacity(16), size(0) {
+        data = new int[capacity];
+    }
+
+    PostingList(const PostingList& other) : capacity(other.capacity), size(other.size) {
+        data = new int[capacity];
+        std::memcpy(data, other.data, sizeof(int) * size);
+    }
+
+    PostingList& operator=(const PostingList& other) {
+        if (this != &other) {
+            delete[] data;
+            capacity = other.capacity;
+            size = other.size;
+            data = new int[capacity];
+            std::memcpy(data, other.data, sizeof(int) * size);
+        }
+        return *this;
+    }
+
+    ~PostingList() {
+        delete[] data;
+    }
+
+    // Documents must be added in increasing order, so the list stays sorted;
+    // intersect and unite rely on it
+    void add(int document) {
+        if (size >= capacity) {
+            resize();
+        }
+        data[size++] = document;
+    }
+
+    int get(int index) const {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data[index];
+    }
+
+    const int* documents() const { return data; }
+
+    int getSize() const {
+        return size;
+    }
+
+    void clear() {
+        size = 0;
+    }
+
+    // Documents in both lists, into `out` (cleared first). Walks the shorter
+    // list and gallops through the longer one.
+    static void intersect(const PostingList& a, const PostingList& b, PostingList& out) {
+        const PostingList& small = a.size <= b.size ? a : b;
+        const PostingList& large = a.size <= b.size ? b : a;
+        out.clear();
+        int j = 0;
+        for (int i = 0; i < small.size && j < large.size; i++) {
+            int target = small.data[i];
+            int step = 1;
+            int hi = j;
+            while (hi < large.size && large.data[hi] < target) {
+                j = hi + 1;
+                hi += step;
+                step *= 2;
+            }
+            j = static_cast<int>(std::lower_bound(large.data + j, large.data + std::min(hi, large.size), target) - large.data);
+            if (j < large.size && large.data[j] == target) {
+                out.add(target);
+            }
+        }
+    }
+
+    // Documents in either list, into `out` (cleared first), by a merge
+    static void unite(const PostingList& a, const PostingList& b, PostingList& out) {
+        out.clear();
+        int i = 0, j = 0;
+        while (i < a.size || j < b.size) {
+            if (j >= b.size || (i < a.size && a.data[i] < b.data[j])) out.add(a.data[i++]);
+            else if (i >= a.size || b.data[j] < a.data[i]) out.add(b.data[j++]);
+            else { out.add(a.data[i++]); j++; }
+        }
+    }
+};
+
+// Inverted index skill -> documents, one compressed bitmap per bit of the skill mask
+class SkillPostings {
+private:
+    RoaringBitmap lists[MAX_ENCODED_SKILLS];
+    uint64_t indexedSkills;   // skills that get a posting bitmap at all
+
+public:
+    SkillPostings() : indexedSkills(~0ull) {}
+
+    // Skills outside `mask` are never posted (e.g. a skill every document has)
+    void setIndexedSkills(uint64_t mask) {
+        indexedSkills = mask;
+    }
+
+    uint64_t getIndexedSkills() const {
+        return indexedSkills;
+    }
+
+    void addDocument(int document, uint64_t skillMask) {
+        uint64_t bits = skillMask & indexedSkills;
+        while (bits) {
+            int skillId = __builtin_ctzll(bits);
+            lists[skillId].add(static_cast<uint32_t>(document));
+            bits &= bits - 1;
+        }
+    }
+
+    // Compacts every bitmap once loading is done
+    void optimize() {
+        for (int i = 0; i < MAX_ENCODED_SKILLS; i++) {
+            lists[i].runOptimize();
+        }
+    }
+
+    const RoaringBitmap& get(int skillId) const {
+        if (skillId < 0 || skillId >= MAX_ENCODED_SKILLS) {
+            throw std::out_of_range("Skill id out of range");
+        }
+        return lists[skillId];
+    }
+
+    // Total number of (skill, document) entries
+    long long getPostingCount() const {
+        long long total = 0;
+        for (int i = 0; i < MAX_ENCODED_SKILLS; i++) {
+            total += lists[i].cardinality();
+        }
+        return total;
+    }
+
+    long long getMemoryBytes() const {
+        long long total = 0;
+        for (int i = 0; i < MAX_ENCODED_SKILLS; i++) {
+            total += lists[i].memoryBytes();
+        }
+        return total;
+    }
+
+    void clear() {
+        for (int i = 0; i < MAX_ENCODED_SKILLS; i++) {
+            lists[i].clear();
+        }
+    }
+};
+
+#endif
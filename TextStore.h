@@ -0,0 +1,161 @@
+#ifndef TEXT_STORE_H
+#define TEXT_STORE_H
+
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+// Document text store that keeps only a short preview of every document in
+// memory. Each document is a byte range (offset, length) of its source file
+// and anything past the inline preview is read back on demand, so resident
+// memory is 48 bytes per document however long the documents are.
+// Source files must not change while their documents are loaded. Documents
+// that have no source file (added from memory) keep their full text resident.
+class LazyTextStore {
+public:
+    static const int PREVIEW_LENGTH = 32;
+    static const int MAX_SOURCES = 16;
+    static const uint16_t MEMORY_SOURCE = 0xFFFF;
+
+private:
+    struct Entry {
+        long long offset;
+        uint32_t length;
+        uint16_t source;
+        uint8_t previewLength;
+        char preview[PREVIEW_LENGTH];
+    };
+
+    Entry* entries;
+    int capacity;
+    int size;
+    std::string sourceNames[MAX_SOURCES];
+    mutable std::ifstream sourceFiles[MAX_SOURCES];   // opened on first fetch
+    int sourceCount;
+    std::string* memoryTexts;   // MEMORY_SOURCE documents, indexed by Entry::offset
+    int memoryCapacity;
+    int memoryCount;
+
+    void resize() {
+        capacity *= 2;
+        Entry* newEntries = new Entry[capacity];
+        std::memcpy(newEntries, entries, sizeof(Entry) * size);
+        delete[] entries;
+        entries = newEntries;
+    }
+
+    const Entry& entry(int index) const {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return entries[index];
+    }
+
+    // First `length` bytes of a document, read from its source file
+    std::string read(const Entry& e, uint32_t length) const {
+        if (e.source == MEMORY_SOURCE) {
+            return memoryTexts[e.offset].substr(0, length);
+        }
+        std::ifstream& file = sourceFiles[e.source];
+        if (!file.is_open()) {
+            file.open(sourceNames[e.source], std::ios::binary);
+        }
+        file.clear();
+        std::string text(length, '\0');
+        if (length > 0 && (!file.seekg(e.offset) || !file.read(&text[0], length))) {
+            throw std::runtime_error("Cannot read document text from " + sourceNames[e.source]);
+        }
+        return text;
+    }
+
+public:
+    LazyTextStore() : capacity(10), size(0), sourceCount(0), memoryTexts(NULL), memoryCapacity(0), memoryCount(0) {
+        entries = new Entry[capacity];
+    }
+
+    ~LazyTextStore() {
+        delete[] entries;
+        delete[] memoryTexts;
+    }
+
+    LazyTextStore(const LazyTextStore&) = delete;
+    LazyTextStore& operator=(const LazyTextStore&) = delete;
+
+    // Id of a source file, registering it on first use
+    int addSource(const std::string& filename) {
+        for (int i = 0; i < sourceCount; i++) {
+            if (sourceNames[i] == filename) {
+                return i;
+            }
+        }
+        if (sourceCount >= MAX_SOURCES) {
+            throw std::length_error("Too many text source files");
+        }
+        sourceNames[sourceCount] = filename;
+        return sourceCount++;
+    }
+
+    // `text` is the document as it appears at `offset` in the source file
+    void add(int source, long long offset, const std::string& text) {
+        if (size >= capacity) {
+            resize();
+        }
+        Entry& e = entries[size++];
+        e.offset = offset;
+        e.length = static_cast<uint32_t>(text.size());
+        e.source = static_cast<uint16_t>(source);
+        e.previewLength = static_cast<uint8_t>(std::min<size_t>(text.size(), PREVIEW_LENGTH));
+        std::memcpy(e.preview, text.data(), e.previewLength);
+    }
+
+    // Document with no source file; the text is kept in memory
+    void addInMemory(const std::string& text) {
+        if (memoryCount >= memoryCapacity) {
+            memoryCapacity = memoryCapacity == 0 ? 10 : memoryCapacity * 2;
+            std::string* grown = new std::string[memoryCapacity];
+            for (int i = 0; i < memoryCount; i++) grown[i].swap(memoryTexts[i]);
+            delete[] memoryTexts;
+            memoryTexts = grown;
+        }
+        memoryTexts[memoryCount] = text;
+        add(MEMORY_SOURCE, memoryCount++, text);
+    }
+
+    // Full text, read from the source file
+    std::string get(int index) const {
+        const Entry& e = entry(index);
+        return read(e, e.length);
+    }
+
+    // First `length` characters; served from memory up to PREVIEW_LENGTH
+    std::string preview(int index, int length = PREVIEW_LENGTH) const {
+        const Entry& e = entry(index);
+        uint32_t wanted = std::min<uint32_t>(e.length, length > 0 ? static_cast<uint32_t>(length) : 0);
+        if (wanted <= e.previewLength) {
+            return std::string(e.preview, wanted);
+        }
+        return read(e, wanted);
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    // Bytes held in memory vs the total length of the stored documents
+    long long memoryBytes() const {
+        long long total = static_cast<long long>(capacity) * sizeof(Entry);
+        for (int i = 0; i < memoryCount; i++) total += memoryTexts[i].capacity();
+        return total;
+    }
+
+    long long textBytes() const {
+        long long total = 0;
+        for (int i = 0; i < size; i++) total += entries[i].length;
+        return total;
+    }
+};
+
+#endif
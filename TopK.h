@@ -0,0 +1,115 @@
+#ifndef TOP_K_H
+#define TOP_K_H
+
+// A scored document and the ranking order shared by every top-K path:
+// higher score first, ties broken by the lower document index.
+struct ScoredIndex {
+    int index;
+    float score;
+};
+
+inline bool ranksBefore(const ScoredIndex& a, const ScoredIndex& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+// Fixed-capacity heap that keeps the best K entries seen so far. The root is the
+// worst kept entry, so a new candidate costs one comparison unless it qualifies.
+class TopKHeap {
+private:
+    ScoredIndex* items;
+    int k;
+    int size;
+
+    void siftUp(int index) {
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (ranksBefore(items[parent], items[index])) {
+                ScoredIndex temp = items[index];
+                items[index] = items[parent];
+                items[parent] = temp;
+                index = parent;
+            } else {
+                break;
+            }
+        }
+    }
+
+    void siftDown(int index) {
+        while (true) {
+            int left = 2 * index + 1;
+            int right = left + 1;
+            int worst = index;
+            if (left < size && ranksBefore(items[worst], items[left])) worst = left;
+            if (right < size && ranksBefore(items[worst], items[right])) worst = right;
+            if (worst == index) break;
+            ScoredIndex temp = items[index];
+            items[index] = items[worst];
+            items[worst] = temp;
+            index = worst;
+        }
+    }
+
+public:
+    explicit TopKHeap(int capacity) : k(capacity > 0 ? capacity : 0), size(0) {
+        items = new ScoredIndex[k > 0 ? k : 1];
+    }
+
+    TopKHeap(const TopKHeap& other) : k(other.k), size(other.size) {
+        items = new ScoredIndex[k > 0 ? k : 1];
+        for (int i = 0; i < size; i++) items[i] = other.items[i];
+    }
+
+    TopKHeap& operator=(const TopKHeap& other) {
+        if (this != &other) {
+            delete[] items;
+            k = other.k;
+            size = other.size;
+            items = new ScoredIndex[k > 0 ? k : 1];
+            for (int i = 0; i < size; i++) items[i] = other.items[i];
+        }
+        return *this;
+    }
+
+    ~TopKHeap() {
+        delete[] items;
+    }
+
+    void offer(int index, float score) {
+        ScoredIndex candidate = {index, score};
+        if (size < k) {
+            items[size] = candidate;
+            siftUp(size++);
+        } else if (k > 0 && ranksBefore(candidate, items[0])) {
+            items[0] = candidate;
+            siftDown(0);
+        }
+    }
+
+    // Once full, a candidate must rank before worst() to get in
+    bool isFull() const { return size == k; }
+    const ScoredIndex& worst() const { return items[0]; }
+
+    int getSize() const { return size; }
+
+    // Copies the kept entries into `out` in ranking order and returns the count
+    int sorted(ScoredIndex* out) const {
+        for (int i = 0; i < size; i++) out[i] = items[i];
+        // insertion sort: K is small
+        for (int i = 1; i < size; i++) {
+            ScoredIndex key = out[i];
+            int j = i - 1;
+            while (j >= 0 && ranksBefore(key, out[j])) {
+                out[j + 1] = out[j];
+                j--;
+            }
+            out[j + 1] = key;
+        }
+        return size;
+    }
+
+    void clear() {
+        size = 0;
+    }
+};
+
+#endif
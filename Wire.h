@@ -0,0 +1,85 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <string>
+#include <cstdint>
+#include <cerrno>
+#include "TopK.h"
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Length-prefixed framing shared by the shard workers and the query server.
+// All integers travel in host byte order: both ends always run on the same machine.
+namespace Wire {
+#ifndef _WIN32
+    inline bool writeFully(int fd, const void* buffer, size_t length) {
+        const char* p = static_cast<const char*>(buffer);
+        while (length > 0) {
+#ifdef MSG_NOSIGNAL
+            ssize_t n = send(fd, p, length, MSG_NOSIGNAL);
+#else
+            ssize_t n = write(fd, p, length);
+#endif
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    inline bool readFully(int fd, void* buffer, size_t length) {
+        char* p = static_cast<char*>(buffer);
+        while (length > 0) {
+            ssize_t n = read(fd, p, length);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    inline bool writeU32(int fd, uint32_t value) {
+        return writeFully(fd, &value, sizeof(value));
+    }
+
+    inline bool readU32(int fd, uint32_t& value) {
+        return readFully(fd, &value, sizeof(value));
+    }
+
+    // Upper bound on a single job text, to reject corrupt length prefixes
+    const uint32_t MAX_TEXT_LENGTH = 1u << 20;
+
+    inline bool writeString(int fd, const std::string& text) {
+        return writeU32(fd, static_cast<uint32_t>(text.size())) &&
+               writeFully(fd, text.data(), text.size());
+    }
+
+    inline bool readString(int fd, std::string& text) {
+        uint32_t length;
+        if (!readU32(fd, length) || length > MAX_TEXT_LENGTH) return false;
+        text.resize(length);
+        return length == 0 || readFully(fd, &text[0], length);
+    }
+
+    inline bool writeMatches(int fd, const ScoredIndex* matches, int count) {
+        return writeU32(fd, static_cast<uint32_t>(count)) &&
+               writeFully(fd, matches, sizeof(ScoredIndex) * count);
+    }
+
+    // `out` must hold `capacity` entries; longer replies are rejected
+    inline bool readMatches(int fd, ScoredIndex* out, int capacity, int& count) {
+        uint32_t n;
+        if (!readU32(fd, n) || n > static_cast<uint32_t>(capacity)) return false;
+        count = static_cast<int>(n);
+        return readFully(fd, out, sizeof(ScoredIndex) * count);
+    }
+#endif
+}
+
+#endif
@@ -5,13 +5,13 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <cstdlib>
 
 #include "ambulance_dispatcher.hpp"
 
 using namespace std;
 
-// constant values and file name for ambulance queue
-const int MAX_AMBULANCES = 20;
+// file name for ambulance queue
 const char* AMBULANCE_DATA_FILE = "ambulance_dispatcher/ambulance_data.txt";
 
 // data for one ambulance
@@ -21,15 +21,139 @@ struct Ambulance {
     string driverName;
 };
 
+// hash index from ambulance id to its slot in the queue
+// (open addressing, linear probing, kept at most half full)
+class AmbulanceIndex {
+private:
+    int* keys;
+    int* slots;    // -1 means empty bucket
+    int capacity;  // power of two
+    int count;
+
+    int bucketOf(int id) const {
+        unsigned int h = static_cast<unsigned int>(id) * 2654435761u;
+        return static_cast<int>(h & static_cast<unsigned int>(capacity - 1));
+    }
+
+    void rehash(int newCapacity) {
+        int* oldKeys = keys;
+        int* oldSlots = slots;
+        int oldCapacity = capacity;
+
+        capacity = newCapacity;
+        keys = new int[capacity];
+        slots = new int[capacity];
+        for (int i = 0; i < capacity; ++i) {
+            slots[i] = -1;
+        }
+        count = 0;
+        for (int i = 0; i < oldCapacity; ++i) {
+            if (oldSlots[i] >= 0) {
+                set(oldKeys[i], oldSlots[i]);
+            }
+        }
+        delete[] oldKeys;
+        delete[] oldSlots;
+    }
+
+public:
+    AmbulanceIndex() {
+        capacity = 32;
+        count = 0;
+        keys = new int[capacity];
+        slots = new int[capacity];
+        for (int i = 0; i < capacity; ++i) {
+            slots[i] = -1;
+        }
+    }
+
+    ~AmbulanceIndex() {
+        delete[] keys;
+        delete[] slots;
+    }
+
+    AmbulanceIndex(const AmbulanceIndex&) = delete;
+    AmbulanceIndex& operator=(const AmbulanceIndex&) = delete;
+
+    // slot of id, or -1 if not registered
+    int get(int id) const {
+        int b = bucketOf(id);
+        while (slots[b] >= 0) {
+            if (keys[b] == id) {
+                return slots[b];
+            }
+            b = (b + 1) & (capacity - 1);
+        }
+        return -1;
+    }
+
+    // add or update id
+    void set(int id, int slot) {
+        if ((count + 1) * 2 > capacity) {
+            rehash(capacity * 2);
+        }
+        int b = bucketOf(id);
+        while (slots[b] >= 0) {
+            if (keys[b] == id) {
+                slots[b] = slot;
+                return;
+            }
+            b = (b + 1) & (capacity - 1);
+        }
+        keys[b] = id;
+        slots[b] = slot;
+        ++count;
+    }
+
+    // remove id, shifting later entries back so lookups never need markers
+    void erase(int id) {
+        int b = bucketOf(id);
+        while (slots[b] >= 0 && keys[b] != id) {
+            b = (b + 1) & (capacity - 1);
+        }
+        if (slots[b] < 0) {
+            return;
+        }
+        slots[b] = -1;
+        --count;
+
+        int next = (b + 1) & (capacity - 1);
+        while (slots[next] >= 0) {
+            int home = bucketOf(keys[next]);
+            // move entry back if its home is not between the hole and its bucket
+            if (((next - home) & (capacity - 1)) >= ((next - b) & (capacity - 1))) {
+                keys[b] = keys[next];
+                slots[b] = slots[next];
+                slots[next] = -1;
+                b = next;
+            }
+            next = (next + 1) & (capacity - 1);
+        }
+    }
+
+    void clear() {
+        for (int i = 0; i < capacity; ++i) {
+            slots[i] = -1;
+        }
+        count = 0;
+    }
+};
+
 // queue class for ambulance rotation
+// growable circular array; a deleted ambulance leaves a tombstone that is
+// dropped once it reaches the front during rotation, or when the array is
+// compacted because it is full. register, rotate and delete are amortized O(1)
 class AmbulanceQueue {
 private:
     // storage and control values for circular queue
-    Ambulance data[MAX_AMBULANCES];
+    Ambulance* data;
+    bool* alive;          // false means tombstone
+    int capacity;         // power of two
     int front;
-    int rear;
-    int count;
-    int nextId;   // next auto generate id
+    int used;             // slots from front to back, tombstones included
+    int count;            // ambulances registered
+    int nextId;           // next auto generate id
+    AmbulanceIndex slotOf;
 
     // helper to make plate text from id
     static string generatePlate(int id) {
@@ -38,42 +162,102 @@ private:
         return oss.str();
     }
 
+    int slotAt(int position) const {
+        return (front + position) & (capacity - 1);
+    }
+
+    // drop tombstones at the front and back so both ends are live
+    void trimEnds() {
+        while (used > 0 && !alive[front]) {
+            front = (front + 1) & (capacity - 1);
+            --used;
+        }
+        while (used > 0 && !alive[slotAt(used - 1)]) {
+            --used;
+        }
+    }
+
+    // copy live ambulances to the start of an array of newCapacity slots
+    void rebuild(int newCapacity) {
+        Ambulance* newData = new Ambulance[newCapacity];
+        bool* newAlive = new bool[newCapacity];
+        int n = 0;
+        for (int i = 0; i < used; ++i) {
+            int slot = slotAt(i);
+            if (alive[slot]) {
+                newData[n].id = data[slot].id;
+                newData[n].plate.swap(data[slot].plate);
+                newData[n].driverName.swap(data[slot].driverName);
+                newAlive[n] = true;
+                slotOf.set(newData[n].id, n);
+                ++n;
+            }
+        }
+        delete[] data;
+        delete[] alive;
+        data = newData;
+        alive = newAlive;
+        capacity = newCapacity;
+        front = 0;
+        used = n;
+    }
+
+    // make room for one more slot at the back
+    void ensureRoom() {
+        if (used < capacity) {
+            return;
+        }
+        // mostly tombstones: compacting in place frees enough room
+        rebuild(count * 2 <= capacity ? capacity : capacity * 2);
+    }
+
+    void pushBack(const Ambulance& a) {
+        ensureRoom();
+        int slot = slotAt(used);
+        data[slot] = a;
+        alive[slot] = true;
+        slotOf.set(a.id, slot);
+        ++used;
+        ++count;
+    }
+
 public:
     // set default values for queue
     AmbulanceQueue() {
+        capacity = 16;
+        data = new Ambulance[capacity];
+        alive = new bool[capacity];
         front = 0;
-        rear  = -1;
+        used  = 0;
         count = 0;
         nextId = 1;
     }
 
+    ~AmbulanceQueue() {
+        delete[] data;
+        delete[] alive;
+    }
+
+    AmbulanceQueue(const AmbulanceQueue&) = delete;
+    AmbulanceQueue& operator=(const AmbulanceQueue&) = delete;
+
     // check if queue has no ambulance
     bool isEmpty() const {
         return count == 0;
     }
 
-    // check if queue is full
-    bool isFull() const {
-        return count == MAX_AMBULANCES;
+    int size() const {
+        return count;
     }
 
     // add new ambulance with auto id and plate
-    bool registerAmbulance(const string& driverName, Ambulance& created) {
-        if (isFull()) {
-            return false;
-        }
-
+    Ambulance registerAmbulance(const string& driverName) {
         Ambulance a;
         a.id = nextId++;
         a.plate = generatePlate(a.id);
         a.driverName = driverName;
-
-        rear = (rear + 1) % MAX_AMBULANCES;
-        data[rear] = a;
-        count++;
-
-        created = a;
-        return true;
+        pushBack(a);
+        return a;
     }
 
     // move first ambulance to back
@@ -82,10 +266,17 @@ public:
             return false;
         }
 
-        Ambulance first = data[front];
-        front = (front + 1) % MAX_AMBULANCES;
-        rear  = (rear  + 1) % MAX_AMBULANCES;
-        data[rear] = first;
+        ensureRoom();
+        int from = front;
+        int to = slotAt(used);
+        data[to].id = data[from].id;
+        data[to].plate.swap(data[from].plate);
+        data[to].driverName.swap(data[from].driverName);
+        alive[to] = true;
+        alive[from] = false;
+        slotOf.set(data[to].id, to);
+        ++used;
+        trimEnds();
 
         return true;
     }
@@ -98,12 +289,15 @@ public:
         }
 
         cout << "\nCurrent Ambulance Rotation (next on duty is first):\n";
-        int index = front;
-        for (int i = 0; i < count; ++i) {
-            cout << (i + 1) << ". ID: " << data[index].id
-                 << " | Plate: " << data[index].plate
-                 << " | Driver: " << data[index].driverName << '\n';
-            index = (index + 1) % MAX_AMBULANCES;
+        int shown = 0;
+        for (int i = 0; i < used; ++i) {
+            int slot = slotAt(i);
+            if (!alive[slot]) {
+                continue;
+            }
+            cout << (++shown) << ". ID: " << data[slot].id
+                 << " | Plate: " << data[slot].plate
+                 << " | Driver: " << data[slot].driverName << '\n';
         }
         cout << endl;
     }
@@ -116,16 +310,18 @@ public:
         }
 
         out << count << '\n';
-        int index = front;
-        for (int i = 0; i < count; ++i) {
-            out << data[index].id << ','
-                << data[index].plate << ','
-                << data[index].driverName << '\n';
-            index = (index + 1) % MAX_AMBULANCES;
+        for (int i = 0; i < used; ++i) {
+            int slot = slotAt(i);
+            if (!alive[slot]) {
+                continue;
+            }
+            out << data[slot].id << ','
+                << data[slot].plate << ','
+                << data[slot].driverName << '\n';
         }
     }
 
-    // load ambulance data from file
+    // load ambulance data from file, however many there are
     void loadFromFile(const string& filename) {
         ifstream in(filename.c_str());
         if (!in) {
@@ -133,9 +329,10 @@ public:
         }
 
         front = 0;
-        rear  = -1;
+        used  = 0;
         count = 0;
         nextId = 1;
+        slotOf.clear();
 
         int n;
         if (!(in >> n)) {
@@ -143,11 +340,22 @@ public:
         }
         in.ignore(numeric_limits<streamsize>::max(), '\n');
 
+        // the count line is only a hint (it may be corrupt); size the array
+        // once for it, capped, and let pushBack grow past that if needed
+        const int MAX_HINT = 1 << 20;
+        int hint = n < MAX_HINT ? n : MAX_HINT;
+        int wanted = 16;
+        while (wanted < hint) {
+            wanted *= 2;
+        }
+        if (wanted > capacity) {
+            rebuild(wanted);
+        }
+
         int maxId = 0;
 
-        for (int i = 0; i < n && i < MAX_AMBULANCES; ++i) {
-            string line;
-            if (!getline(in, line)) break;
+        string line;
+        while (getline(in, line)) {
             if (line.empty()) continue;
 
             stringstream ss(line);
@@ -158,17 +366,18 @@ public:
             if (!getline(ss, nameStr)) continue;
 
             Ambulance a;
-            a.id = stoi(idStr);
+            a.id = atoi(idStr.c_str());
             a.plate = plateStr;
             a.driverName = nameStr;
 
+            // ids must be unique for the index
+            if (a.id <= 0 || slotOf.get(a.id) >= 0) continue;
+
             if (a.id > maxId) {
                 maxId = a.id;
             }
 
-            rear = (rear + 1) % MAX_AMBULANCES;
-            data[rear] = a;
-            ++count;
+            pushBack(a);
         }
 
         if (maxId >= 1) {
@@ -180,39 +389,17 @@ public:
 
     // remove ambulance by id
     bool removeById(int id) {
-        if (isEmpty()) {
+        int slot = slotOf.get(id);
+        if (slot < 0) {
             return false;
         }
 
-        Ambulance temp[MAX_AMBULANCES];
-        int newCount = 0;
-        bool removed = false;
-
-        int idx = front;
-        for (int i = 0; i < count; ++i) {
-            if (!removed && data[idx].id == id) {
-                removed = true;
-            } else {
-                temp[newCount++] = data[idx];
-            }
-            idx = (idx + 1) % MAX_AMBULANCES;
-        }
-
-        if (!removed) {
-            return false;
-        }
-
-        front = 0;
-        count = newCount;
-
-        if (newCount == 0) {
-            rear = -1;
-        } else {
-            for (int i = 0; i < newCount; ++i) {
-                data[i] = temp[i];
-            }
-            rear = newCount - 1;
-        }
+        alive[slot] = false;
+        data[slot].plate.clear();
+        data[slot].driverName.clear();
+        slotOf.erase(id);
+        --count;
+        trimEnds();
 
         return true;
     }
@@ -255,11 +442,6 @@ void ambulance_dispatcher() {
 
         // handle user choice to register ambulance
         if (choice == 1) {
-            if (ambulanceQueue.isFull()) {
-                cout << "Queue is full. Cannot register more ambulances.\n";
-                continue;
-            }
-
             string driverName;
             cout << "Enter Driver Name: ";
             getline(cin, driverName);
@@ -268,14 +450,10 @@ void ambulance_dispatcher() {
                 continue;
             }
 
-            Ambulance created;
-            if (ambulanceQueue.registerAmbulance(driverName, created)) {
-                cout << "Ambulance registered successfully.\n";
-                cout << "Assigned ID: " << created.id << '\n';
-                cout << "Assigned Plate: " << created.plate << '\n';
-            } else {
-                cout << "Queue is full. Cannot register more ambulances.\n";
-            }
+            Ambulance created = ambulanceQueue.registerAmbulance(driverName);
+            cout << "Ambulance registered successfully.\n";
+            cout << "Assigned ID: " << created.id << '\n';
+            cout << "Assigned Plate: " << created.plate << '\n';
 
         // handle user choice to rotate shift
         } else if (choice == 2) {
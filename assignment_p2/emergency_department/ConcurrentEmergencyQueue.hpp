@@ -0,0 +1,224 @@
+#ifndef CONCURRENT_EMERGENCY_QUEUE_HPP
+#define CONCURRENT_EMERGENCY_QUEUE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <string>
+#include "HospitalEmergency.hpp"
+
+// Emergency queue for several triage desks and clinicians at once: a
+// MultiQueue of independently locked shards, each a BucketPriorityQueue.
+//
+// - enqueue locks one random shard (another if that one is busy).
+// - tryDequeue reads the head priority of each shard without locking,
+//   starting from a random shard, and stops at the first one holding a
+//   priority-1 case. It then locks only the shard it chose.
+//
+// With five levels the scan is short, and the random start spreads the
+// clinicians over the shards. No lock is ever held across shards. The
+// ordering is relaxed: a dequeue can pass over a more urgent case that
+// arrives, or is taken, while it scans. Equal priorities leave in arrival
+// order only within a shard.
+class ConcurrentEmergencyQueue {
+private:
+    static const int EMPTY = CaseStore::MAX_PRIORITY + 1;   // head priority of an empty shard
+
+    struct Shard {
+        std::mutex lock;
+        BucketPriorityQueue queue;
+        std::atomic<int> top;    // head priority, EMPTY when empty; read without the lock
+        char pad[64];            // keeps neighbouring shards' hot fields off this cache line
+
+        Shard() : top(EMPTY) {}
+    };
+
+    Shard* shards;
+    int shardCount;
+    std::atomic<int> pending;
+
+    // Per-thread xorshift, so picking a shard never touches shared state
+    static unsigned int randomIndex(int bound) {
+        static thread_local unsigned int state = 0;
+        if (state == 0) {
+            state = static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        }
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % static_cast<unsigned int>(bound);
+    }
+
+    static void refreshTop(Shard& shard) {
+        shard.top.store(shard.queue.isEmpty() ? EMPTY : shard.queue.peekPriority(), std::memory_order_release);
+    }
+
+    // Pops from a locked shard; false if it turned out empty
+    bool popLocked(Shard& shard, EmergencyCase& out, std::atomic<long long>* clock, long long* stamp) {
+        if (shard.queue.isEmpty()) {
+            return false;
+        }
+        out = shard.queue.dequeue();
+        if (clock) {
+            *stamp = clock->fetch_add(1);
+        }
+        refreshTop(shard);
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void push(const EmergencyCase& newCase, std::atomic<long long>* clock, long long* stamp) {
+        CaseStore::checkedPriority(newCase.getPriorityLevel());
+        int index = static_cast<int>(randomIndex(shardCount));
+        for (int attempt = 0; !shards[index].lock.try_lock(); attempt++) {
+            if (attempt == 4) {
+                shards[index].lock.lock();
+                break;
+            }
+            index = static_cast<int>(randomIndex(shardCount));
+        }
+        Shard& shard = shards[index];
+        shard.queue.enqueue(newCase);
+        if (clock) {
+            *stamp = clock->fetch_add(1);
+        }
+        refreshTop(shard);
+        pending.fetch_add(1, std::memory_order_relaxed);
+        shard.lock.unlock();
+    }
+
+    bool take(EmergencyCase& out, std::atomic<long long>* clock, long long* stamp) {
+        for (int attempt = 0; ; attempt++) {
+            int start = static_cast<int>(randomIndex(shardCount));
+            int best = -1;
+            int bestTop = EMPTY;
+            for (int i = 0; i < shardCount; i++) {
+                int index = (start + i) % shardCount;
+                int top = shards[index].top.load(std::memory_order_acquire);
+                if (top < bestTop) {
+                    best = index;
+                    bestTop = top;
+                    if (top == CaseStore::MIN_PRIORITY) {
+                        break;
+                    }
+                }
+            }
+            if (best < 0) {
+                return false;
+            }
+            Shard& shard = shards[best];
+            if (attempt < 4) {
+                if (!shard.lock.try_lock()) {
+                    continue;   // someone is on it: rescan from another shard
+                }
+            } else {
+                shard.lock.lock();
+            }
+            bool taken = popLocked(shard, out, clock, stamp);
+            shard.lock.unlock();
+            if (taken) {
+                return true;
+            }
+        }
+    }
+
+public:
+    // A few shards per worker thread keeps collisions rare
+    explicit ConcurrentEmergencyQueue(int shards = 0) : pending(0) {
+        if (shards <= 0) {
+            int threads = static_cast<int>(std::thread::hardware_concurrency());
+            shards = 4 * (threads > 0 ? threads : 1);
+        }
+        shardCount = shards < 2 ? 2 : shards;
+        this->shards = new Shard[shardCount];
+    }
+
+    ~ConcurrentEmergencyQueue() {
+        delete[] shards;
+    }
+
+    ConcurrentEmergencyQueue(const ConcurrentEmergencyQueue&) = delete;
+    ConcurrentEmergencyQueue& operator=(const ConcurrentEmergencyQueue&) = delete;
+
+    // Case IDs must be unique across the whole queue; priority must be 1..5
+    void enqueue(const EmergencyCase& newCase) {
+        push(newCase, NULL, NULL);
+    }
+
+    // Takes a case of the most urgent priority seen; false if every shard
+    // was empty
+    bool tryDequeue(EmergencyCase& out) {
+        return take(out, NULL, NULL);
+    }
+
+    // Same as above, but each also draws the next number from `clock` while
+    // its shard is still locked. The stamps give one order of all stamped
+    // operations that agrees with what every shard saw, so a test can replay
+    // them afterwards to see which cases were waiting at each dequeue.
+    long long enqueue(const EmergencyCase& newCase, std::atomic<long long>& clock) {
+        long long stamp = 0;
+        push(newCase, &clock, &stamp);
+        return stamp;
+    }
+
+    bool tryDequeue(EmergencyCase& out, std::atomic<long long>& clock, long long& stamp) {
+        return take(out, &clock, &stamp);
+    }
+
+    // Approximate while other threads are working
+    int getSize() const {
+        return pending.load(std::memory_order_relaxed);
+    }
+
+    bool isEmpty() const {
+        return getSize() == 0;
+    }
+
+    int getShardCount() const {
+        return shardCount;
+    }
+};
+
+// Intake and treatment for several triage desks and clinicians at once, on
+// top of ConcurrentEmergencyQueue. Every method may be called from any
+// thread. Unlike EmergencyDepartment it keeps no journal and prints nothing;
+// callers get the outcome back and report it themselves.
+class ConcurrentEmergencyDepartment {
+private:
+    ConcurrentEmergencyQueue emergencyQueue;
+    std::atomic<int> nextCaseID;
+
+public:
+    explicit ConcurrentEmergencyDepartment(int shards = 0, int firstCaseID = 1)
+        : emergencyQueue(shards), nextCaseID(firstCaseID) {}
+
+    // ID of the new case, or 0 if the name or type is empty or the priority
+    // is outside 1..5
+    int logEmergencyCase(const std::string& patientName, const std::string& emergencyType, int priorityLevel) {
+        if (patientName.empty() || emergencyType.empty() ||
+            priorityLevel < CaseStore::MIN_PRIORITY || priorityLevel > CaseStore::MAX_PRIORITY) {
+            return 0;
+        }
+        int caseID = nextCaseID.fetch_add(1);
+        emergencyQueue.enqueue(EmergencyCase(patientName, emergencyType, priorityLevel, caseID));
+        return caseID;
+    }
+
+    // Hands the most critical waiting case (within the queue's relaxed
+    // order) to the calling clinician; false if no case is waiting
+    bool processMostCriticalCase(EmergencyCase& treated) {
+        return emergencyQueue.tryDequeue(treated);
+    }
+
+    bool hasPendingCases() const {
+        return !emergencyQueue.isEmpty();
+    }
+
+    // Approximate while other threads are working
+    int getPendingCasesCount() const {
+        return emergencyQueue.getSize();
+    }
+};
+
+#endif
@@ -0,0 +1,456 @@
+#ifndef EMERGENCY_LOG_HPP
+#define EMERGENCY_LOG_HPP
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Write-ahead log for the emergency department. Every change to the queue is
+// appended as one binary record before it is applied:
+//
+//   [u32 body length][u32 CRC-32 of body][body]
+//   body = u64 sequence, u8 event, i32 case ID, u8 priority,
+//          then for CASE_LOGGED: i64 arrival, u16 + name bytes, u16 + type bytes
+//
+// Integers are little-endian. A record that is cut short or fails its checksum
+// is a write torn by a crash: it ends the log and is cut off on recovery.
+//
+// The data file is the snapshot. Its header holds the sequence number of the
+// last event it includes, and recovery replays only later events. Compaction
+// renames the log to <log>.old and starts an empty one; a background thread
+// then writes the snapshot and deletes <log>.old.
+
+struct LogEvent {
+    enum Type { CASE_LOGGED = 1, CASE_PROCESSED = 2, CASE_REPRIORITIZED = 3, CASE_REMOVED = 4 };
+
+    unsigned long long sequence;   // assigned by append
+    int type;
+    int caseID;
+    int priority;                  // CASE_LOGGED and CASE_REPRIORITIZED
+    long long arrival;             // CASE_LOGGED only
+    std::string patientName;       // CASE_LOGGED only
+    std::string emergencyType;     // CASE_LOGGED only
+
+    LogEvent() : sequence(0), type(0), caseID(0), priority(0), arrival(0) {}
+
+    LogEvent(int eventType, int id, int newPriority = 0)
+        : sequence(0), type(eventType), caseID(id), priority(newPriority), arrival(0) {}
+};
+
+struct LogOptions {
+    int syncEvery;              // fsync after this many events: 1 = every event, 0 = left to the OS
+    long long compactBytes;     // log size that starts a background snapshot, 0 = only on save
+
+    LogOptions() : syncEvery(1), compactBytes(4 << 20) {}
+};
+
+class EmergencyLog {
+private:
+    static const unsigned int MAX_RECORD = 1 << 20;
+
+    std::string logPath;
+    std::string oldLogPath;
+    LogOptions options;
+    int fd;                          // -1 until recover
+    long long logBytes;
+    unsigned long long lastSequence;
+    int unsynced;                    // events appended since the last fsync
+    std::thread compactor;
+    std::atomic<bool> compactorDone;
+    std::string compactError;        // set by the compactor, read after join
+
+    static unsigned int crc32(const char* data, size_t length) {
+        static unsigned int table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (unsigned int i = 0; i < 256; i++) {
+                unsigned int c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[i] = c;
+            }
+            ready = true;
+        }
+        unsigned int crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < length; i++) {
+            crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    static void putInt(std::string& out, unsigned long long value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    static unsigned long long getInt(const char* in, int bytes) {
+        unsigned long long value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<unsigned long long>(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    static void putText(std::string& out, const std::string& text) {
+        size_t length = text.size() < 0xFFFF ? text.size() : 0xFFFF;
+        putInt(out, length, 2);
+        out.append(text, 0, length);
+    }
+
+    static bool getText(const char*& p, const char* end, std::string& text) {
+        if (end - p < 2) return false;
+        size_t length = static_cast<size_t>(getInt(p, 2));
+        p += 2;
+        if (static_cast<size_t>(end - p) < length) return false;
+        text.assign(p, length);
+        p += length;
+        return true;
+    }
+
+    static std::string encode(const LogEvent& e) {
+        std::string body;
+        putInt(body, e.sequence, 8);
+        putInt(body, static_cast<unsigned int>(e.type), 1);
+        putInt(body, static_cast<unsigned int>(e.caseID), 4);
+        putInt(body, static_cast<unsigned int>(e.priority), 1);
+        if (e.type == LogEvent::CASE_LOGGED) {
+            putInt(body, static_cast<unsigned long long>(e.arrival), 8);
+            putText(body, e.patientName);
+            putText(body, e.emergencyType);
+        }
+        std::string record;
+        record.reserve(8 + body.size());
+        putInt(record, body.size(), 4);
+        putInt(record, crc32(body.data(), body.size()), 4);
+        record += body;
+        return record;
+    }
+
+    // Decodes the record at `p` and advances past it; false on a torn or
+    // corrupt record
+    static bool decode(const char*& p, const char* end, LogEvent& e) {
+        if (end - p < 8) return false;
+        unsigned int length = static_cast<unsigned int>(getInt(p, 4));
+        unsigned int crc = static_cast<unsigned int>(getInt(p + 4, 4));
+        if (length < 14 || length > MAX_RECORD || static_cast<unsigned int>(end - p - 8) < length) return false;
+        const char* body = p + 8;
+        const char* bodyEnd = body + length;
+        if (crc32(body, length) != crc) return false;
+
+        e.sequence = getInt(body, 8);
+        e.type = static_cast<int>(getInt(body + 8, 1));
+        e.caseID = static_cast<int>(static_cast<unsigned int>(getInt(body + 9, 4)));
+        e.priority = static_cast<int>(getInt(body + 13, 1));
+        const char* q = body + 14;
+        if (e.type == LogEvent::CASE_LOGGED) {
+            if (bodyEnd - q < 8) return false;
+            e.arrival = static_cast<long long>(getInt(q, 8));
+            q += 8;
+            if (!getText(q, bodyEnd, e.patientName) || !getText(q, bodyEnd, e.emergencyType)) return false;
+        } else if (e.type < LogEvent::CASE_PROCESSED || e.type > LogEvent::CASE_REMOVED) {
+            return false;
+        }
+        p = bodyEnd;
+        return true;
+    }
+
+    // Thin layer over the OS file calls so the rest reads the same on both
+#ifdef _WIN32
+    static int openFile(const std::string& path, int flags) {
+        return _open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+    }
+    static int writeSome(int file, const char* data, size_t length) {
+        return _write(file, data, static_cast<unsigned int>(length));
+    }
+    static int readSome(int file, char* data, size_t length) {
+        return _read(file, data, static_cast<unsigned int>(length));
+    }
+    static bool syncFile(int file) { return _commit(file) == 0; }
+    static void closeFile(int file) { _close(file); }
+    static bool truncateFile(int file, long long length) { return _chsize_s(file, length) == 0; }
+    static void syncDirectoryOf(const std::string&) {}
+    // rename() does not replace an existing file on Windows
+    static bool replaceFile(const std::string& from, const std::string& to) {
+        std::remove(to.c_str());
+        return std::rename(from.c_str(), to.c_str()) == 0;
+    }
+#else
+    static int openFile(const std::string& path, int flags) {
+        return open(path.c_str(), flags, 0644);
+    }
+    static int writeSome(int file, const char* data, size_t length) {
+        return static_cast<int>(write(file, data, length));
+    }
+    static int readSome(int file, char* data, size_t length) {
+        return static_cast<int>(read(file, data, length));
+    }
+    static bool syncFile(int file) { return fsync(file) == 0; }
+    static void closeFile(int file) { close(file); }
+    static bool truncateFile(int file, long long length) { return ftruncate(file, length) == 0; }
+    // Makes a rename or create in the file's directory durable
+    static void syncDirectoryOf(const std::string& path) {
+        size_t slash = path.rfind('/');
+        std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        int file = open(dir.c_str(), O_RDONLY);
+        if (file >= 0) {
+            fsync(file);
+            close(file);
+        }
+    }
+    static bool replaceFile(const std::string& from, const std::string& to) {
+        return std::rename(from.c_str(), to.c_str()) == 0;
+    }
+#endif
+
+    static bool fileExists(const std::string& path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0;
+    }
+
+    static bool writeAll(int file, const char* data, size_t length) {
+        while (length > 0) {
+            int written = writeSome(file, data, length);
+            if (written <= 0) return false;
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    static bool readAll(const std::string& path, std::string& out) {
+        out.clear();
+        int file = openFile(path, O_RDONLY);
+        if (file < 0) return false;
+        char chunk[65536];
+        int got;
+        while ((got = readSome(file, chunk, sizeof(chunk))) > 0) {
+            out.append(chunk, static_cast<size_t>(got));
+        }
+        closeFile(file);
+        return got == 0;
+    }
+
+    // Writes `contents` to a temporary file, syncs it and renames it over `path`
+    static bool writeFileAtomically(const std::string& path, const std::string& contents, std::string& error) {
+        std::string tempPath = path + ".tmp";
+        int file = openFile(tempPath, O_WRONLY | O_CREAT | O_TRUNC);
+        if (file < 0) {
+            error = "Cannot open file for writing: " + tempPath;
+            return false;
+        }
+        bool ok = writeAll(file, contents.data(), contents.size()) && syncFile(file);
+        closeFile(file);
+        if (!ok || !replaceFile(tempPath, path)) {
+            std::remove(tempPath.c_str());
+            error = "Cannot write snapshot: " + path;
+            return false;
+        }
+        syncDirectoryOf(path);
+        return true;
+    }
+
+    // Applies every intact record of `path` newer than `after`; returns the
+    // length of the intact prefix
+    template <typename Apply>
+    long long replayFile(const std::string& path, unsigned long long after, Apply& apply, int& replayed) {
+        std::string data;
+        if (!readAll(path, data)) {
+            return 0;
+        }
+        const char* begin = data.data();
+        const char* p = begin;
+        const char* end = begin + data.size();
+        LogEvent e;
+        while (p < end && decode(p, end, e)) {
+            if (e.sequence > lastSequence) {
+                lastSequence = e.sequence;
+            }
+            if (e.sequence > after) {
+                apply(e);
+                replayed++;
+            }
+        }
+        if (p < end) {
+            std::cout << "Discarded " << (end - p) << " bytes of incomplete log records in " << path << std::endl;
+        }
+        return p - begin;
+    }
+
+    void waitForCompaction() {
+        if (compactor.joinable()) {
+            compactor.join();
+        }
+    }
+
+    void closeLog() {
+        if (fd >= 0) {
+            if (unsynced > 0) syncFile(fd);
+            closeFile(fd);
+            fd = -1;
+        }
+    }
+
+    bool openLog(bool truncate) {
+        fd = openFile(logPath, O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0));
+        unsynced = 0;
+        if (truncate) {
+            logBytes = 0;
+        }
+        return fd >= 0;
+    }
+
+public:
+    EmergencyLog(const std::string& path, const LogOptions& logOptions = LogOptions())
+        : logPath(path), oldLogPath(path + ".old"), options(logOptions), fd(-1),
+          logBytes(0), lastSequence(0), unsynced(0), compactorDone(false) {}
+
+    ~EmergencyLog() {
+        waitForCompaction();
+        closeLog();
+    }
+
+    EmergencyLog(const EmergencyLog&) = delete;
+    EmergencyLog& operator=(const EmergencyLog&) = delete;
+
+    // Calls apply(const LogEvent&) for every logged event after `after` (the
+    // snapshot's sequence), <log>.old first, cuts a torn tail off the log and
+    // opens it for appending. Returns the number of events replayed.
+    template <typename Apply>
+    int recover(unsigned long long after, Apply apply) {
+        waitForCompaction();
+        closeLog();
+        lastSequence = after;
+        int replayed = 0;
+        if (fileExists(oldLogPath)) {
+            replayFile(oldLogPath, after, apply, replayed);
+        }
+        long long intact = replayFile(logPath, after, apply, replayed);
+        if (!openLog(false)) {
+            std::cout << "Error: Cannot open log file: " << logPath << std::endl;
+            return replayed;
+        }
+        truncateFile(fd, intact);
+        logBytes = intact;
+        return replayed;
+    }
+
+    // True while <log>.old is left over from an unfinished compaction; the
+    // caller should save a snapshot to retire it
+    bool hasStaleLog() const {
+        return fileExists(oldLogPath);
+    }
+
+    // Stamps the next sequence number on `e` and appends it, syncing every
+    // options.syncEvery events (group commit)
+    bool append(LogEvent& e) {
+        if (fd < 0) {
+            recover(0, [](const LogEvent&) {});
+            if (fd < 0) return false;
+        }
+        e.sequence = lastSequence + 1;
+        std::string record = encode(e);
+        bool written = writeAll(fd, record.data(), record.size());
+        if (written && options.syncEvery > 0 && unsynced + 1 >= options.syncEvery) {
+            written = syncFile(fd);
+            if (written) {
+                unsynced = -1;
+            }
+        }
+        if (!written) {
+            // The caller refuses the change, so it must not be replayed, and a
+            // partial record would hide every later one: cut back to before it
+            truncateFile(fd, logBytes);
+            return false;
+        }
+        lastSequence = e.sequence;
+        logBytes += static_cast<long long>(record.size());
+        unsynced++;
+        return true;
+    }
+
+    bool sync() {
+        if (fd < 0 || unsynced == 0) return true;
+        unsynced = 0;
+        return syncFile(fd);
+    }
+
+    bool shouldCompact() const {
+        return options.compactBytes > 0 && logBytes >= options.compactBytes && !compactor.joinable();
+    }
+
+    unsigned long long getLastSequence() const {
+        return lastSequence;
+    }
+
+    long long getLogBytes() const {
+        return logBytes;
+    }
+
+    // Makes `snapshot` (the state after getLastSequence()) the new data file and
+    // empties the log. In the background the caller only waits for the log
+    // switch; the snapshot write and fsync happen on the compactor thread.
+    bool compact(const std::string& dataPath, const std::string& snapshot, bool background) {
+        waitForCompaction();
+        if (fd < 0) {
+            recover(0, [](const LogEvent&) {});
+        }
+        sync();
+
+        // A failed earlier compaction left <log>.old: its events and the log's
+        // are all in this snapshot, so write it first and only then drop both
+        if (fileExists(oldLogPath)) {
+            if (!writeFileAtomically(dataPath, snapshot, compactError)) {
+                return false;
+            }
+            std::remove(oldLogPath.c_str());
+            closeLog();
+            return openLog(true);
+        }
+
+        closeLog();
+        if (!replaceFile(logPath, oldLogPath) || !openLog(true)) {
+            compactError = "Cannot start a new log: " + logPath;
+            openLog(false);
+            return false;
+        }
+        syncDirectoryOf(logPath);
+
+        compactorDone = false;
+        std::string oldPath = oldLogPath;
+        compactor = std::thread([this, dataPath, snapshot, oldPath]() {
+            if (writeFileAtomically(dataPath, snapshot, compactError)) {
+                std::remove(oldPath.c_str());
+            }
+            compactorDone = true;
+        });
+        if (!background) {
+            waitForCompaction();
+            return compactError.empty();
+        }
+        return true;
+    }
+
+    // Joins a finished background compaction; returns its error, if any
+    std::string takeError() {
+        if (compactor.joinable()) {
+            if (!compactorDone) return "";
+            compactor.join();
+        }
+        std::string error;
+        error.swap(compactError);
+        return error;
+    }
+};
+
+#endif
@@ -7,44 +7,143 @@
 #include <fstream>
 #include <stdexcept>
 #include <limits>
+#include <utility>
+#include "EmergencyLog.hpp"
+#include <cstring>
 
 class EmergencyCase {
 private:
     std::string patientName;
     std::string emergencyType;
     int priorityLevel;  // 1 = Highest (Critical), 5 = Lowest (Minor)
-    std::string arrivalTime;
+    long long arrivalTime;  // seconds since the epoch, formatted only for display/save
     int caseID;
 
-    std::string getCurrentTime() {
-        std::time_t now = std::time(0);
-        std::string timeStr = std::ctime(&now);
+public:
+    // ctime() layout without the newline, e.g. "Sun Oct 12 18:15:30 2025"
+    static std::string formatTime(long long timestamp) {
+        std::time_t t = static_cast<std::time_t>(timestamp);
+        const char* text = std::ctime(&t);
+        if (!text) {
+            return std::to_string(timestamp);
+        }
+        std::string timeStr = text;
         if (!timeStr.empty() && timeStr[timeStr.length()-1] == '\n') {
             timeStr.erase(timeStr.length()-1);
         }
         return timeStr;
     }
 
-public:
-    EmergencyCase() : patientName(""), emergencyType(""), priorityLevel(5), caseID(0) {
-        arrivalTime = getCurrentTime();
+    // Reads an unsigned decimal at `p`, advancing it; false if there is none
+    static bool parseNumber(const char*& p, const char* end, long long& value) {
+        const char* first = p;
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            p++;
+        }
+        return p != first;
+    }
+
+    // Inverse of formatTime (local time); plain epoch seconds are accepted too.
+    // Returns 0 when the text is neither. Parses in place, no allocation.
+    static long long parseTime(const char* begin, const char* end) {
+        static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        long long value;
+        const char* p = begin;
+        if (parseNumber(p, end, value)) {
+            return p == end ? value : 0;
+        }
+        if (end - begin < 8 || begin[3] != ' ') {
+            return 0;
+        }
+        int month = -1;
+        for (int m = 0; m < 12; m++) {
+            if (std::memcmp(begin + 4, months + 3 * m, 3) == 0) {
+                month = m;
+            }
+        }
+        // "Www Mmm dd hh:mm:ss yyyy", day padded with a space when below 10
+        long long day, hour, minute, second, year;
+        p = begin + 7;
+        while (p < end && *p == ' ') p++;
+        if (month < 0 || !parseNumber(p, end, day) || p == end || *p++ != ' ' ||
+            !parseNumber(p, end, hour) || p == end || *p++ != ':' ||
+            !parseNumber(p, end, minute) || p == end || *p++ != ':' ||
+            !parseNumber(p, end, second) || p == end || *p++ != ' ' ||
+            !parseNumber(p, end, year) || p != end) {
+            return 0;
+        }
+        // mktime dominates bulk loads and saved cases cluster in time, so the
+        // start of the last hour seen is cached (offset changes fall on hours)
+        static thread_local long long cachedHourKey = -1;
+        static thread_local long long cachedHourStart = 0;
+        long long hourKey = ((year * 12 + month) * 32 + day) * 24 + hour;
+        if (hourKey != cachedHourKey) {
+            std::tm fields = std::tm();
+            fields.tm_year = static_cast<int>(year) - 1900;
+            fields.tm_mon = month;
+            fields.tm_mday = static_cast<int>(day);
+            fields.tm_hour = static_cast<int>(hour);
+            fields.tm_isdst = -1;
+            cachedHourStart = static_cast<long long>(std::mktime(&fields));
+            cachedHourKey = hourKey;
+        }
+        return cachedHourStart + minute * 60 + second;
+    }
+
+    static long long parseTime(const std::string& text) {
+        return parseTime(text.data(), text.data() + text.size());
     }
+
+    // Parses one saved line "caseID,name,type,priority,arrival" in place; `end`
+    // is one past the last character. False (and `out` untouched) if malformed.
+    static bool parseLine(const char* begin, const char* end, EmergencyCase& out) {
+        const char* commas[4];
+        const char* p = begin;
+        for (int i = 0; i < 4; i++) {
+            p = static_cast<const char*>(std::memchr(p, ',', end - p));
+            if (!p) {
+                return false;
+            }
+            commas[i] = p++;
+        }
+        long long id, priority;
+        const char* cursor = begin;
+        if (!parseNumber(cursor, commas[0], id) || cursor != commas[0]) {
+            return false;
+        }
+        cursor = commas[2] + 1;
+        if (!parseNumber(cursor, commas[3], priority) || cursor != commas[3]) {
+            return false;
+        }
+        out.caseID = static_cast<int>(id);
+        out.patientName.assign(commas[0] + 1, commas[1]);
+        out.emergencyType.assign(commas[1] + 1, commas[2]);
+        out.priorityLevel = static_cast<int>(priority);
+        out.arrivalTime = parseTime(commas[3] + 1, end);
+        return true;
+    }
+
+    // No clock read: cases built for loading get their time from the file
+    EmergencyCase() : patientName(""), emergencyType(""), priorityLevel(5), arrivalTime(0), caseID(0) {}
     
     EmergencyCase(const std::string& name, const std::string& type, int priority, int id) 
-        : patientName(name), emergencyType(type), priorityLevel(priority), caseID(id) {
-        arrivalTime = getCurrentTime();
-    }
+        : patientName(name), emergencyType(type), priorityLevel(priority),
+          arrivalTime(static_cast<long long>(std::time(0))), caseID(id) {}
     
     std::string getPatientName() const { return patientName; }
     std::string getEmergencyType() const { return emergencyType; }
     int getPriorityLevel() const { return priorityLevel; }
-    std::string getArrivalTime() const { return arrivalTime; }
+    std::string getArrivalTime() const { return formatTime(arrivalTime); }
+    long long getArrivalTimestamp() const { return arrivalTime; }
     int getCaseID() const { return caseID; }
     
     void setPatientName(const std::string& name) { patientName = name; }
     void setEmergencyType(const std::string& type) { emergencyType = type; }
     void setPriorityLevel(int priority) { priorityLevel = priority; }
     void setCaseID(int id) { caseID = id; }
+    void setArrivalTimestamp(long long timestamp) { arrivalTime = timestamp; }
     
     bool operator<(const EmergencyCase& other) const {
         return this->priorityLevel > other.priorityLevel;
@@ -54,45 +153,484 @@ public:
         return this->priorityLevel < other.priorityLevel;
     }
     
+    // Display and save layouts, shared with cases read in place from a queue
+    static void displayFields(int id, const std::string& name, const std::string& type,
+                              int priority, long long arrival) {
+        std::cout << "ID: " << id << " | Patient: " << name 
+                  << " | Type: " << type 
+                  << " | Priority: " << priority 
+                  << " | Arrived: " << formatTime(arrival) << std::endl;
+    }
+    
+    static std::string formatFields(int id, const std::string& name, const std::string& type,
+                                    int priority, long long arrival) {
+        return std::to_string(id) + "," + name + "," + 
+               type + "," + std::to_string(priority) + "," + formatTime(arrival);
+    }
+    
     void displayCase() const {
-        std::cout << "ID: " << caseID << " | Patient: " << patientName 
-                  << " | Type: " << emergencyType 
-                  << " | Priority: " << priorityLevel 
-                  << " | Arrived: " << arrivalTime << std::endl;
+        displayFields(caseID, patientName, emergencyType, priorityLevel, arrivalTime);
     }
     
     std::string toString() const {
-        return std::to_string(caseID) + "," + patientName + "," + 
-               emergencyType + "," + std::to_string(priorityLevel) + "," + arrivalTime;
+        return formatFields(caseID, patientName, emergencyType, priorityLevel, arrivalTime);
     }
     
     void fromString(const std::string& data) {
-        size_t pos1 = data.find(',');
-        size_t pos2 = data.find(',', pos1 + 1);
-        size_t pos3 = data.find(',', pos2 + 1);
-        size_t pos4 = data.find(',', pos3 + 1);
-        
-        if (pos1 != std::string::npos && pos2 != std::string::npos && 
-            pos3 != std::string::npos && pos4 != std::string::npos) {
-            caseID = std::stoi(data.substr(0, pos1));
-            patientName = data.substr(pos1 + 1, pos2 - pos1 - 1);
-            emergencyType = data.substr(pos2 + 1, pos3 - pos2 - 1);
-            priorityLevel = std::stoi(data.substr(pos3 + 1, pos4 - pos3 - 1));
-            arrivalTime = data.substr(pos4 + 1);
+        parseLine(data.data(), data.data() + data.size(), *this);
+    }
+};
+
+// caseID -> heap slot, open addressing with linear probing. Kept at most half
+// full; erase shifts later entries back so lookups never need tombstones.
+class CaseSlotIndex {
+private:
+    static const int EMPTY = -1;
+
+    int* keys;      // caseID, EMPTY = free slot
+    int* slots;
+    int tableSize;  // power of two
+    int count;
+
+    int bucketOf(int caseID) const {
+        unsigned int h = static_cast<unsigned int>(caseID) * 2654435761u;
+        return static_cast<int>(h & static_cast<unsigned int>(tableSize - 1));
+    }
+
+    int findBucket(int caseID) const {
+        int mask = tableSize - 1;
+        for (int b = bucketOf(caseID); keys[b] != EMPTY; b = (b + 1) & mask) {
+            if (keys[b] == caseID) {
+                return b;
+            }
+        }
+        return -1;
+    }
+
+    void allocate(int size) {
+        tableSize = size;
+        keys = new int[tableSize];
+        slots = new int[tableSize];
+        for (int i = 0; i < tableSize; i++) {
+            keys[i] = EMPTY;
+        }
+    }
+
+    void grow() {
+        int* oldKeys = keys;
+        int* oldSlots = slots;
+        int oldSize = tableSize;
+        allocate(tableSize * 2);
+        count = 0;
+        for (int i = 0; i < oldSize; i++) {
+            if (oldKeys[i] != EMPTY) {
+                set(oldKeys[i], oldSlots[i]);
+            }
+        }
+        delete[] oldKeys;
+        delete[] oldSlots;
+    }
+
+public:
+    CaseSlotIndex() : count(0) {
+        allocate(32);
+    }
+
+    ~CaseSlotIndex() {
+        delete[] keys;
+        delete[] slots;
+    }
+
+    CaseSlotIndex(const CaseSlotIndex& other) : count(other.count) {
+        allocate(other.tableSize);
+        for (int i = 0; i < tableSize; i++) {
+            keys[i] = other.keys[i];
+            slots[i] = other.slots[i];
         }
     }
+
+    CaseSlotIndex& operator=(const CaseSlotIndex& other) {
+        if (this != &other) {
+            delete[] keys;
+            delete[] slots;
+            count = other.count;
+            allocate(other.tableSize);
+            for (int i = 0; i < tableSize; i++) {
+                keys[i] = other.keys[i];
+                slots[i] = other.slots[i];
+            }
+        }
+        return *this;
+    }
+
+    // Inserts or updates
+    void set(int caseID, int slot) {
+        int mask = tableSize - 1;
+        int b = bucketOf(caseID);
+        while (keys[b] != EMPTY && keys[b] != caseID) {
+            b = (b + 1) & mask;
+        }
+        if (keys[b] == EMPTY) {
+            if ((count + 1) * 2 > tableSize) {
+                grow();
+                set(caseID, slot);
+                return;
+            }
+            keys[b] = caseID;
+            count++;
+        }
+        slots[b] = slot;
+    }
+
+    // Heap slot of a case, -1 if not queued
+    int get(int caseID) const {
+        int b = findBucket(caseID);
+        return b < 0 ? -1 : slots[b];
+    }
+
+    void erase(int caseID) {
+        int b = findBucket(caseID);
+        if (b < 0) {
+            return;
+        }
+        int mask = tableSize - 1;
+        keys[b] = EMPTY;
+        count--;
+        // Move back any later entry of the probe run that could live in the hole
+        for (int next = (b + 1) & mask; keys[next] != EMPTY; next = (next + 1) & mask) {
+            int home = bucketOf(keys[next]);
+            bool movable = (b <= next) ? (home <= b || home > next) : (home <= b && home > next);
+            if (movable) {
+                keys[b] = keys[next];
+                slots[b] = slots[next];
+                keys[next] = EMPTY;
+                b = next;
+            }
+        }
+    }
+
+    void clear() {
+        for (int i = 0; i < tableSize; i++) {
+            keys[i] = EMPTY;
+        }
+        count = 0;
+    }
+};
+
+// Hot part of a queued case: the only thing the queues compare and move
+// (24 bytes, against ~80 for a full EmergencyCase with its strings)
+struct CaseRecord {
+    long long agingFrom;      // aging anchor, epoch seconds (see CaseStore::joinLevel)
+    unsigned int seq;         // arrival order, breaks priority ties (FIFO)
+    int caseID;
+    int payload;              // patient name slot in CaseStore
+    unsigned short typeID;    // EmergencyTypeTable id
+    unsigned char priority;   // 1..5
 };
 
+// Aging: every `secondsPerLevel` seconds of waiting improve a case by one
+// priority level (effective priority = priority - waited / secondsPerLevel).
+// Compared at the same moment, that orders cases exactly like this key, which
+// does not change while they wait, so no queue ever has to rescan.
+inline long long agedKey(const CaseRecord& r, long long secondsPerLevel) {
+    return r.agingFrom + (r.priority - 1) * secondsPerLevel;
+}
+
+// Lower (effective) priority first, then earlier arrival; aging is off when
+// secondsPerLevel is 0. The sequence comparison survives wrap-around while
+// fewer than 2^31 cases are pending.
+inline bool ranksBefore(const CaseRecord& a, const CaseRecord& b, long long secondsPerLevel = 0) {
+    if (secondsPerLevel > 0) {
+        long long keyA = agedKey(a, secondsPerLevel);
+        long long keyB = agedKey(b, secondsPerLevel);
+        if (keyA != keyB) {
+            return keyA < keyB;
+        }
+    } else if (a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return static_cast<int>(a.seq - b.seq) < 0;
+}
+
+// Interned emergency types: every distinct text is stored once and cases keep a
+// 16-bit id. Types are never removed; the set of emergencies is small.
+class EmergencyTypeTable {
+private:
+    static const int MAX_TYPES = 65536;
+
+    std::string* names;
+    int count;
+    int capacity;
+    int* table;      // type id + 1, 0 = empty; kept at most half full
+    int tableSize;   // power of two
+
+    // FNV-1a
+    static unsigned int hashOf(const std::string& text) {
+        unsigned int h = 2166136261u;
+        for (size_t i = 0; i < text.size(); i++) {
+            h = (h ^ static_cast<unsigned char>(text[i])) * 16777619u;
+        }
+        return h;
+    }
+
+    void rehash(int newSize) {
+        delete[] table;
+        tableSize = newSize;
+        table = new int[tableSize];
+        for (int i = 0; i < tableSize; i++) {
+            table[i] = 0;
+        }
+        for (int id = 0; id < count; id++) {
+            int b = static_cast<int>(hashOf(names[id]) & static_cast<unsigned int>(tableSize - 1));
+            while (table[b] != 0) {
+                b = (b + 1) & (tableSize - 1);
+            }
+            table[b] = id + 1;
+        }
+    }
+
+public:
+    EmergencyTypeTable() : count(0), capacity(16), table(NULL) {
+        names = new std::string[capacity];
+        rehash(64);
+    }
+
+    ~EmergencyTypeTable() {
+        delete[] names;
+        delete[] table;
+    }
+
+    EmergencyTypeTable(const EmergencyTypeTable&) = delete;
+    EmergencyTypeTable& operator=(const EmergencyTypeTable&) = delete;
+
+    // Id of `type`, adding it on first use
+    int intern(const std::string& type) {
+        int b = static_cast<int>(hashOf(type) & static_cast<unsigned int>(tableSize - 1));
+        while (table[b] != 0) {
+            if (names[table[b] - 1] == type) {
+                return table[b] - 1;
+            }
+            b = (b + 1) & (tableSize - 1);
+        }
+        if (count >= MAX_TYPES) {
+            throw std::length_error("Too many distinct emergency types");
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            std::string* grown = new std::string[capacity];
+            for (int i = 0; i < count; i++) {
+                grown[i].swap(names[i]);
+            }
+            delete[] names;
+            names = grown;
+        }
+        names[count] = type;
+        table[b] = count + 1;
+        count++;
+        if (count * 2 > tableSize) {
+            rehash(tableSize * 2);
+        }
+        return count - 1;
+    }
+
+    const std::string& nameOf(int id) const {
+        return names[id];
+    }
+
+    int getCount() const {
+        return count;
+    }
+};
+
+// Cold side of the queued cases: patient names and arrival times in a slab with
+// a free list, interned types, the arrival sequence counter and the aging
+// anchors per level. Queues hold CaseRecords and come here only when a case
+// enters, leaves, changes level or is displayed.
+class CaseStore {
+public:
+    static const int MIN_PRIORITY = 1;
+    static const int MAX_PRIORITY = 5;
+
+private:
+    EmergencyTypeTable types;
+    std::string* names;
+    long long* arrivals;
+    int* freeSlots;
+    int nameCount;      // slots handed out so far
+    int nameCapacity;
+    int freeCount;
+    unsigned int nextSeq;
+    long long levelAnchor[MAX_PRIORITY + 1];   // latest aging anchor given out per level
+
+    void resetAnchors() {
+        for (int p = 0; p <= MAX_PRIORITY; p++) {
+            levelAnchor[p] = std::numeric_limits<long long>::min();
+        }
+    }
+
+    int takeSlot() {
+        if (freeCount > 0) {
+            return freeSlots[--freeCount];
+        }
+        if (nameCount == nameCapacity) {
+            nameCapacity *= 2;
+            std::string* grown = new std::string[nameCapacity];
+            for (int i = 0; i < nameCount; i++) {
+                grown[i].swap(names[i]);
+            }
+            delete[] names;
+            names = grown;
+            long long* grownArrivals = new long long[nameCapacity];
+            std::memcpy(grownArrivals, arrivals, sizeof(long long) * nameCount);
+            delete[] arrivals;
+            arrivals = grownArrivals;
+            delete[] freeSlots;
+            freeSlots = new int[nameCapacity];
+        }
+        return nameCount++;
+    }
+
+public:
+    CaseStore() : nameCount(0), nameCapacity(16), freeCount(0), nextSeq(0) {
+        names = new std::string[nameCapacity];
+        arrivals = new long long[nameCapacity];
+        freeSlots = new int[nameCapacity];
+        resetAnchors();
+    }
+
+    ~CaseStore() {
+        delete[] names;
+        delete[] arrivals;
+        delete[] freeSlots;
+    }
+
+    CaseStore(const CaseStore&) = delete;
+    CaseStore& operator=(const CaseStore&) = delete;
+
+    static int checkedPriority(int priority) {
+        if (priority < MIN_PRIORITY || priority > MAX_PRIORITY) {
+            throw std::out_of_range("Priority level must be between 1 and 5");
+        }
+        return priority;
+    }
+
+    // Next arrival sequence number
+    unsigned int sequence() {
+        return nextSeq++;
+    }
+
+    // Aging anchor for a case joining the back of `priority`'s level: its own
+    // anchor, but never earlier than the case that joined before it. Anchors
+    // then rise in FIFO order within every level, in both queues, so a
+    // re-triaged case ages from when it joined its new level rather than
+    // jumping ahead of the cases already waiting there.
+    long long joinLevel(int priority, long long anchor) {
+        if (anchor < levelAnchor[priority]) {
+            anchor = levelAnchor[priority];
+        }
+        levelAnchor[priority] = anchor;
+        return anchor;
+    }
+
+    // Stores the cold fields of a case entering a queue and returns its record
+    CaseRecord admit(const EmergencyCase& c) {
+        CaseRecord record;
+        record.priority = static_cast<unsigned char>(checkedPriority(c.getPriorityLevel()));
+        record.typeID = static_cast<unsigned short>(types.intern(c.getEmergencyType()));
+        record.agingFrom = joinLevel(record.priority, c.getArrivalTimestamp());
+        record.caseID = c.getCaseID();
+        record.seq = sequence();
+        record.payload = takeSlot();
+        names[record.payload] = c.getPatientName();
+        arrivals[record.payload] = c.getArrivalTimestamp();
+        return record;
+    }
+
+    // Moves a queued record to the back of another level
+    void retriage(CaseRecord& record, int newPriority) {
+        record.priority = static_cast<unsigned char>(checkedPriority(newPriority));
+        record.agingFrom = joinLevel(record.priority, record.agingFrom);
+        record.seq = sequence();
+    }
+
+    // Frees the cold fields of a case leaving its queue
+    void release(const CaseRecord& record) {
+        names[record.payload].clear();
+        freeSlots[freeCount++] = record.payload;
+    }
+
+    EmergencyCase toCase(const CaseRecord& record) const {
+        EmergencyCase c(names[record.payload], types.nameOf(record.typeID), record.priority, record.caseID);
+        c.setArrivalTimestamp(arrivals[record.payload]);
+        return c;
+    }
+
+    const std::string& nameOf(const CaseRecord& record) const {
+        return names[record.payload];
+    }
+
+    long long arrivalOf(const CaseRecord& record) const {
+        return arrivals[record.payload];
+    }
+
+    const std::string& typeOf(const CaseRecord& record) const {
+        return types.nameOf(record.typeID);
+    }
+
+    // Drops every payload; interned types stay
+    void clear() {
+        for (int i = 0; i < nameCount; i++) {
+            names[i].clear();
+        }
+        nameCount = 0;
+        freeCount = 0;
+        resetAnchors();
+    }
+};
+
+// A queued case read in place (forEachInOrder), with EmergencyCase's accessors
+class QueuedCase {
+private:
+    const CaseRecord& record;
+    const CaseStore& store;
+
+public:
+    QueuedCase(const CaseRecord& r, const CaseStore& s) : record(r), store(s) {}
+
+    int getCaseID() const { return record.caseID; }
+    int getPriorityLevel() const { return record.priority; }
+    const std::string& getPatientName() const { return store.nameOf(record); }
+    const std::string& getEmergencyType() const { return store.typeOf(record); }
+    long long getArrivalTimestamp() const { return store.arrivalOf(record); }
+
+    void displayCase() const {
+        EmergencyCase::displayFields(record.caseID, store.nameOf(record), store.typeOf(record),
+                                     record.priority, store.arrivalOf(record));
+    }
+
+    std::string toString() const {
+        return EmergencyCase::formatFields(record.caseID, store.nameOf(record), store.typeOf(record),
+                                           record.priority, store.arrivalOf(record));
+    }
+};
+
+// Binary heap over CaseRecords; names and types live in the CaseStore. Equal
+// priorities leave in arrival order, and a re-triaged case queues behind the
+// cases already waiting at its new level. With aging on, the heap is ordered
+// by agedKey instead of the plain priority.
 class PriorityQueue {
 private:
-    EmergencyCase* heapArray;
+    CaseRecord* heapArray;
     int capacity;
     int currentSize;
+    CaseSlotIndex slotOf;   // caseID -> index in heapArray, updated on every move
+    CaseStore store;
+    long long agingSeconds; // 0 = no aging
     
     void heapifyUp(int index) {
         while (index > 0) {
             int parent = (index - 1) / 2;
-            if (heapArray[index] > heapArray[parent]) {
+            if (ranksBefore(heapArray[index], heapArray[parent], agingSeconds)) {
                 swapCases(index, parent);
                 index = parent;
             } else {
@@ -107,11 +645,11 @@ private:
             int rightChild = 2 * index + 2;
             int largest = index;
             
-            if (leftChild < currentSize && heapArray[leftChild] > heapArray[largest]) {
+            if (leftChild < currentSize && ranksBefore(heapArray[leftChild], heapArray[largest], agingSeconds)) {
                 largest = leftChild;
             }
             
-            if (rightChild < currentSize && heapArray[rightChild] > heapArray[largest]) {
+            if (rightChild < currentSize && ranksBefore(heapArray[rightChild], heapArray[largest], agingSeconds)) {
                 largest = rightChild;
             }
             
@@ -125,61 +663,86 @@ private:
     }
     
     void swapCases(int index1, int index2) {
-        EmergencyCase temp = heapArray[index1];
-        heapArray[index1] = heapArray[index2];
-        heapArray[index2] = temp;
+        std::swap(heapArray[index1], heapArray[index2]);
+        slotOf.set(heapArray[index1].caseID, index1);
+        slotOf.set(heapArray[index2].caseID, index2);
+    }
+
+    // Moves the case in `index` up or down to where it belongs
+    void restore(int index) {
+        if (index > 0 && ranksBefore(heapArray[index], heapArray[(index - 1) / 2], agingSeconds)) {
+            heapifyUp(index);
+        } else {
+            heapifyDown(index);
+        }
+    }
+
+    // Removes the case in `index`, filling the hole with the last case, and
+    // returns it as an EmergencyCase
+    EmergencyCase removeAt(int index) {
+        CaseRecord removed = heapArray[index];
+        slotOf.erase(removed.caseID);
+        currentSize--;
+        if (index < currentSize) {
+            heapArray[index] = heapArray[currentSize];
+            slotOf.set(heapArray[index].caseID, index);
+            restore(index);
+        }
+        EmergencyCase taken = store.toCase(removed);
+        store.release(removed);
+        return taken;
     }
     
+    // heapifyDown over an array of slot indices (forEachInOrder's frontier)
+    void siftFrontier(int* frontier, int size, int index) const {
+        while (true) {
+            int left = 2 * index + 1;
+            int right = left + 1;
+            int best = index;
+            if (left < size && ranksBefore(heapArray[frontier[left]], heapArray[frontier[best]], agingSeconds)) best = left;
+            if (right < size && ranksBefore(heapArray[frontier[right]], heapArray[frontier[best]], agingSeconds)) best = right;
+            if (best == index) break;
+            std::swap(frontier[index], frontier[best]);
+            index = best;
+        }
+    }
+    
+    // Records are plain data, so growth is a straight copy with no constructors
     void resizeHeap() {
         int newCapacity = capacity * 2;
-        EmergencyCase* newHeap = new EmergencyCase[newCapacity];
-        
-        for (int i = 0; i < currentSize; i++) {
-            newHeap[i] = heapArray[i];
-        }
-        
+        CaseRecord* newHeap = new CaseRecord[newCapacity];
+        std::memcpy(newHeap, heapArray, sizeof(CaseRecord) * currentSize);
         delete[] heapArray;
         heapArray = newHeap;
         capacity = newCapacity;
     }
     
 public:
-    PriorityQueue() : capacity(10), currentSize(0) {
-        heapArray = new EmergencyCase[capacity];
+    PriorityQueue() : capacity(10), currentSize(0), agingSeconds(0) {
+        heapArray = new CaseRecord[capacity];
     }
     
     ~PriorityQueue() {
         delete[] heapArray;
     }
     
-    PriorityQueue(const PriorityQueue& other) : capacity(other.capacity), currentSize(other.currentSize) {
-        heapArray = new EmergencyCase[capacity];
-        for (int i = 0; i < currentSize; i++) {
-            heapArray[i] = other.heapArray[i];
-        }
-    }
-    
-    PriorityQueue& operator=(const PriorityQueue& other) {
-        if (this != &other) {
-            delete[] heapArray;
-            capacity = other.capacity;
-            currentSize = other.currentSize;
-            heapArray = new EmergencyCase[capacity];
-            for (int i = 0; i < currentSize; i++) {
-                heapArray[i] = other.heapArray[i];
-            }
-        }
-        return *this;
-    }
+    // Not copyable: snapshots go through forEachInOrder
+    PriorityQueue(const PriorityQueue&) = delete;
+    PriorityQueue& operator=(const PriorityQueue&) = delete;
     
+    // Case IDs must be unique within the queue; priority must be 1..5
     void enqueue(const EmergencyCase& newCase) {
+        if (contains(newCase.getCaseID())) {
+            throw std::invalid_argument("Case ID " + std::to_string(newCase.getCaseID()) + " is already queued");
+        }
         if (currentSize >= capacity) {
             resizeHeap();
         }
         
-        heapArray[currentSize] = newCase;
-        heapifyUp(currentSize);
+        heapArray[currentSize] = store.admit(newCase);
+        slotOf.set(newCase.getCaseID(), currentSize);
         currentSize++;
+        heapifyUp(currentSize - 1);
     }
     
     EmergencyCase dequeue() {
@@ -187,22 +750,107 @@ public:
             throw std::runtime_error("Cannot dequeue from empty priority queue");
         }
         
-        EmergencyCase highestPriority = heapArray[0];
-        heapArray[0] = heapArray[currentSize - 1];
-        currentSize--;
-        
-        if (currentSize > 0) {
-            heapifyDown(0);
+        return removeAt(0);
+    }
+    
+    // Bulk loading: reserve, pushUnordered every case, then heapify once. The
+    // queue is not in heap order between the first pushUnordered and heapify.
+    void reserve(int count) {
+        while (capacity < count) {
+            resizeHeap();
         }
-        
-        return highestPriority;
+    }
+    
+    // False (case dropped) if the ID is already queued
+    bool pushUnordered(EmergencyCase&& newCase) {
+        if (contains(newCase.getCaseID())) {
+            return false;
+        }
+        if (currentSize >= capacity) {
+            resizeHeap();
+        }
+        heapArray[currentSize] = store.admit(newCase);
+        slotOf.set(newCase.getCaseID(), currentSize);
+        currentSize++;
+        return true;
+    }
+    
+    // Bottom-up heap construction, O(n)
+    void heapify() {
+        for (int i = currentSize / 2 - 1; i >= 0; i--) {
+            heapifyDown(i);
+        }
+    }
+    
+    void clear() {
+        currentSize = 0;
+        slotOf.clear();
+        store.clear();
+    }
+    
+    // Seconds of waiting worth one priority level, 0 to turn aging off. The
+    // aged order does not drift with time, so only this change reorders the
+    // heap (one O(n) heapify).
+    void setAging(long long secondsPerLevel) {
+        if (secondsPerLevel < 0) {
+            throw std::invalid_argument("Aging interval cannot be negative");
+        }
+        agingSeconds = secondsPerLevel;
+        heapify();
+    }
+    
+    // O(1)
+    bool contains(int caseID) const {
+        return slotOf.get(caseID) >= 0;
+    }
+    
+    // O(log n); false if the case is not queued
+    bool changePriority(int caseID, int newPriority) {
+        int index = slotOf.get(caseID);
+        if (index < 0) {
+            return false;
+        }
+        store.retriage(heapArray[index], newPriority);
+        restore(index);
+        return true;
+    }
+    
+    // O(log n); copies the removed case into `removed` when given
+    bool remove(int caseID, EmergencyCase* removed = NULL) {
+        int index = slotOf.get(caseID);
+        if (index < 0) {
+            return false;
+        }
+        EmergencyCase taken = removeAt(index);
+        if (removed) {
+            *removed = taken;
+        }
+        return true;
+    }
+    
+    // O(1); false if the case is not queued
+    bool find(int caseID, EmergencyCase& out) const {
+        int index = slotOf.get(caseID);
+        if (index < 0) {
+            return false;
+        }
+        out = store.toCase(heapArray[index]);
+        return true;
     }
     
     EmergencyCase peek() const {
         if (isEmpty()) {
             throw std::runtime_error("Cannot peek empty priority queue");
         }
-        return heapArray[0];
+        return store.toCase(heapArray[0]);
+    }
+    
+    // Priority of the next case, without building it
+    int peekPriority() const {
+        if (isEmpty()) {
+            throw std::runtime_error("Cannot peek empty priority queue");
+        }
+        return heapArray[0].priority;
     }
     
     bool isEmpty() const {
@@ -222,7 +870,7 @@ public:
         std::cout << "\n=== ALL CASES IN PRIORITY QUEUE ===" << std::endl;
         for (int i = 0; i < currentSize; i++) {
             std::cout << (i + 1) << ". ";
-            heapArray[i].displayCase();
+            QueuedCase(heapArray[i], store).displayCase();
         }
         std::cout << "===================================" << std::endl;
     }
@@ -234,32 +882,501 @@ public:
         }
         
         std::cout << "\n=== PENDING EMERGENCY CASES (Priority Order) ===" << std::endl;
-        PriorityQueue tempQueue = *this;
         int count = 1;
+        forEachInOrder([&count](const QueuedCase& c) {
+            std::cout << count++ << ". ";
+            c.displayCase();
+        });
+        std::cout << "================================================" << std::endl;
+    }
+    
+    // Calls visit(QueuedCase) for the first `limit` queued cases (all when
+    // negative) in dequeue order, without copying or disturbing the heap. A small
+    // heap of slot indices holds the frontier: popping slot i exposes its
+    // children 2i+1 and 2i+2.
+    template <typename Visit>
+    void forEachInOrder(Visit visit, int limit = -1) const {
+        if (limit < 0 || limit > currentSize) {
+            limit = currentSize;
+        }
+        if (limit == 0) {
+            return;
+        }
+        int* frontier = new int[limit + 1];   // grows by at most one per case emitted
+        int frontierSize = 0;
+        frontier[frontierSize++] = 0;
         
-        while (!tempQueue.isEmpty()) {
-            std::cout << count << ". ";
-            tempQueue.dequeue().displayCase();
-            count++;
+        for (int emitted = 0; emitted < limit; emitted++) {
+            int slot = frontier[0];
+            visit(QueuedCase(heapArray[slot], store));
+            
+            // Replace the root with the children that exist, then sift
+            frontier[0] = frontier[--frontierSize];
+            siftFrontier(frontier, frontierSize, 0);
+            for (int child = 2 * slot + 1; child <= 2 * slot + 2 && child < currentSize; child++) {
+                int i = frontierSize++;
+                frontier[i] = child;
+                while (i > 0 && ranksBefore(heapArray[frontier[i]], heapArray[frontier[(i - 1) / 2]], agingSeconds)) {
+                    std::swap(frontier[i], frontier[(i - 1) / 2]);
+                    i = (i - 1) / 2;
+                }
+            }
+        }
+        delete[] frontier;
+    }
+};
+
+// Priority queue specialised for the fixed 1..5 triage range: one FIFO ring per
+// priority level plus a bitmask of the non-empty levels. Enqueue and dequeue are
+// O(1) and cases of equal priority leave strictly in arrival order. Cancelled
+// or re-triaged cases are tombstoned in their ring and skipped when they reach
+// the head; a re-triaged case joins the back of its new level. With aging on,
+// dequeue compares the aged keys of the five ring heads.
+class BucketPriorityQueue {
+public:
+    static const int MIN_PRIORITY = CaseStore::MIN_PRIORITY;
+    static const int MAX_PRIORITY = CaseStore::MAX_PRIORITY;
+    static const int LEVELS = MAX_PRIORITY - MIN_PRIORITY + 1;
+
+private:
+    struct Ring {
+        CaseRecord* cases;
+        bool* alive;     // false = tombstone
+        int capacity;    // power of two
+        int head;
+        int count;       // occupied slots, tombstones included
+        int live;
+    };
+
+    Ring rings[LEVELS];
+    unsigned int nonEmpty;   // bit b set when rings[b] has a live case
+    int currentSize;
+    long long agingSeconds;  // 0 = no aging
+    CaseSlotIndex slotOf;    // caseID -> slot * LEVELS + level
+    CaseStore store;
+
+    static void allocate(Ring& ring, int capacity) {
+        ring.cases = new CaseRecord[capacity];
+        ring.alive = new bool[capacity];
+        ring.capacity = capacity;
+        ring.head = 0;
+        ring.count = 0;
+        ring.live = 0;
+    }
+
+    // Copies the live cases of a ring to the front of a new ring of
+    // `capacity` slots, dropping tombstones and re-indexing the moved cases
+    void rebuild(int level, int capacity) {
+        Ring& ring = rings[level];
+        CaseRecord* oldCases = ring.cases;
+        bool* oldAlive = ring.alive;
+        int oldCapacity = ring.capacity;
+        int oldHead = ring.head;
+        int oldCount = ring.count;
+
+        allocate(ring, capacity);
+        for (int i = 0; i < oldCount; i++) {
+            int from = (oldHead + i) & (oldCapacity - 1);
+            if (oldAlive[from]) {
+                ring.cases[ring.count] = oldCases[from];
+                ring.alive[ring.count] = true;
+                slotOf.set(ring.cases[ring.count].caseID, ring.count * LEVELS + level);
+                ring.count++;
+                ring.live++;
+            }
+        }
+        delete[] oldCases;
+        delete[] oldAlive;
+    }
+
+    // Drops tombstones sitting at the head of a ring
+    static void skipDead(Ring& ring) {
+        while (ring.count > 0 && !ring.alive[ring.head]) {
+            ring.head = (ring.head + 1) & (ring.capacity - 1);
+            ring.count--;
+        }
+    }
+
+    void push(const CaseRecord& record) {
+        int level = record.priority - MIN_PRIORITY;
+        Ring& ring = rings[level];
+        if (ring.count == ring.capacity) {
+            // Mostly tombstones: compacting frees enough room, so the ring
+            // grows with the pending cases rather than with the operations
+            rebuild(level, ring.live * 2 <= ring.capacity ? ring.capacity : ring.capacity * 2);
+        }
+        int slot = (ring.head + ring.count) & (ring.capacity - 1);
+        ring.cases[slot] = record;
+        ring.alive[slot] = true;
+        ring.count++;
+        ring.live++;
+        slotOf.set(record.caseID, slot * LEVELS + level);
+        nonEmpty |= 1u << level;
+        currentSize++;
+    }
+
+    // Tombstones a queued case and returns its record; `encoded` comes from slotOf
+    CaseRecord kill(int encoded) {
+        Ring& ring = rings[encoded % LEVELS];
+        int slot = encoded / LEVELS;
+        ring.alive[slot] = false;
+        ring.live--;
+        if (ring.live == 0) {
+            nonEmpty &= ~(1u << (encoded % LEVELS));
+        }
+        currentSize--;
+        slotOf.erase(ring.cases[slot].caseID);
+        CaseRecord taken = ring.cases[slot];
+        skipDead(ring);
+        return taken;
+    }
+
+    // Removes a queued case for good and returns it as an EmergencyCase
+    EmergencyCase take(int encoded) {
+        CaseRecord record = kill(encoded);
+        EmergencyCase taken = store.toCase(record);
+        store.release(record);
+        return taken;
+    }
+
+    int firstLevel() const {
+        int level = 0;
+        while (!(nonEmpty & (1u << level))) {
+            level++;
+        }
+        return level;
+    }
+
+    // Level of the next case. With aging, the head of each ring has the
+    // earliest aging anchor in its level (CaseStore::joinLevel keeps anchors in
+    // FIFO order), so the heads' aged keys, computed on the fly, decide between
+    // levels without looking at any other case.
+    int nextLevel() const {
+        int best = firstLevel();
+        if (agingSeconds == 0) {
+            return best;
+        }
+        for (int level = best + 1; level < LEVELS; level++) {
+            if ((nonEmpty & (1u << level)) &&
+                ranksBefore(rings[level].cases[rings[level].head], rings[best].cases[rings[best].head], agingSeconds)) {
+                best = level;
+            }
+        }
+        return best;
+    }
+
+    void resetRings() {
+        for (int b = 0; b < LEVELS; b++) {
+            delete[] rings[b].cases;
+            delete[] rings[b].alive;
+            allocate(rings[b], 8);
+        }
+    }
+
+    // Aged forEachInOrder: one cursor per ring, always advancing the best one
+    template <typename Visit>
+    void mergeInOrder(Visit& visit, int limit) const {
+        int position[LEVELS];
+        for (int b = 0; b < LEVELS; b++) {
+            position[b] = 0;
+        }
+        for (; limit > 0; limit--) {
+            int best = -1;
+            for (int b = 0; b < LEVELS; b++) {
+                const Ring& ring = rings[b];
+                while (position[b] < ring.count && !ring.alive[(ring.head + position[b]) & (ring.capacity - 1)]) {
+                    position[b]++;
+                }
+                if (position[b] < ring.count &&
+                    (best < 0 || ranksBefore(ring.cases[(ring.head + position[b]) & (ring.capacity - 1)],
+                                             rings[best].cases[(rings[best].head + position[best]) & (rings[best].capacity - 1)],
+                                             agingSeconds))) {
+                    best = b;
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+            const Ring& ring = rings[best];
+            visit(QueuedCase(ring.cases[(ring.head + position[best]) & (ring.capacity - 1)], store));
+            position[best]++;
+        }
+    }
+
+public:
+    BucketPriorityQueue() : nonEmpty(0), currentSize(0), agingSeconds(0) {
+        for (int b = 0; b < LEVELS; b++) {
+            allocate(rings[b], 8);
+        }
+    }
+
+    ~BucketPriorityQueue() {
+        for (int b = 0; b < LEVELS; b++) {
+            delete[] rings[b].cases;
+            delete[] rings[b].alive;
+        }
+    }
+
+    // Not copyable: snapshots go through forEachInOrder
+    BucketPriorityQueue(const BucketPriorityQueue&) = delete;
+    BucketPriorityQueue& operator=(const BucketPriorityQueue&) = delete;
+
+    // Case IDs must be unique within the queue; priority must be 1..5
+    void enqueue(const EmergencyCase& newCase) {
+        if (contains(newCase.getCaseID())) {
+            throw std::invalid_argument("Case ID " + std::to_string(newCase.getCaseID()) + " is already queued");
+        }
+        push(store.admit(newCase));
+    }
+
+    EmergencyCase dequeue() {
+        if (isEmpty()) {
+            throw std::runtime_error("Cannot dequeue from empty priority queue");
+        }
+        int level = nextLevel();
+        return take(rings[level].head * LEVELS + level);
+    }
+
+    // Same bulk-loading interface as PriorityQueue; appends are already O(1)
+    void reserve(int) {}
+
+    bool pushUnordered(EmergencyCase&& newCase) {
+        if (contains(newCase.getCaseID())) {
+            return false;
+        }
+        push(store.admit(newCase));
+        return true;
+    }
+
+    void heapify() {}
+
+    void clear() {
+        resetRings();
+        nonEmpty = 0;
+        currentSize = 0;
+        slotOf.clear();
+        store.clear();
+    }
+
+    EmergencyCase peek() const {
+        if (isEmpty()) {
+            throw std::runtime_error("Cannot peek empty priority queue");
+        }
+        const Ring& ring = rings[nextLevel()];
+        return store.toCase(ring.cases[ring.head]);
+    }
+
+    // Priority of the next case, without building it
+    int peekPriority() const {
+        if (isEmpty()) {
+            throw std::runtime_error("Cannot peek empty priority queue");
+        }
+        return MIN_PRIORITY + nextLevel();
+    }
+
+    bool isEmpty() const {
+        return currentSize == 0;
+    }
+
+    int getSize() const {
+        return currentSize;
+    }
+
+    // O(1)
+    bool contains(int caseID) const {
+        return slotOf.get(caseID) >= 0;
+    }
+
+    // Seconds of waiting worth one priority level, 0 to turn aging off. As in
+    // PriorityQueue, a re-triaged case ages from when it joined its new level.
+    void setAging(long long secondsPerLevel) {
+        if (secondsPerLevel < 0) {
+            throw std::invalid_argument("Aging interval cannot be negative");
+        }
+        agingSeconds = secondsPerLevel;
+    }
+
+    // O(1); false if the case is not queued
+    bool changePriority(int caseID, int newPriority) {
+        int encoded = slotOf.get(caseID);
+        if (encoded < 0) {
+            return false;
+        }
+        CaseStore::checkedPriority(newPriority);
+        CaseRecord moved = kill(encoded);
+        store.retriage(moved, newPriority);
+        push(moved);
+        return true;
+    }
+
+    // O(1); copies the removed case into `removed` when given
+    bool remove(int caseID, EmergencyCase* removed = NULL) {
+        int encoded = slotOf.get(caseID);
+        if (encoded < 0) {
+            return false;
+        }
+        EmergencyCase taken = take(encoded);
+        if (removed) {
+            *removed = taken;
+        }
+        return true;
+    }
+
+    // O(1); false if the case is not queued
+    bool find(int caseID, EmergencyCase& out) const {
+        int encoded = slotOf.get(caseID);
+        if (encoded < 0) {
+            return false;
+        }
+        out = store.toCase(rings[encoded % LEVELS].cases[encoded / LEVELS]);
+        return true;
+    }
+
+    // Calls visit(QueuedCase) for the first `limit` queued cases (all when
+    // negative) in dequeue order; the rings already hold that order, and with
+    // aging they are merged by the same head comparison as dequeue
+    template <typename Visit>
+    void forEachInOrder(Visit visit, int limit = -1) const {
+        if (limit < 0) {
+            limit = currentSize;
+        }
+        if (agingSeconds > 0) {
+            mergeInOrder(visit, limit);
+            return;
         }
+        for (int b = 0; b < LEVELS && limit > 0; b++) {
+            const Ring& ring = rings[b];
+            for (int i = 0; i < ring.count && limit > 0; i++) {
+                int slot = (ring.head + i) & (ring.capacity - 1);
+                if (ring.alive[slot]) {
+                    visit(QueuedCase(ring.cases[slot], store));
+                    limit--;
+                }
+            }
+        }
+    }
+
+    void displayAll() const {
+        if (isEmpty()) {
+            std::cout << "No cases in the priority queue." << std::endl;
+            return;
+        }
+
+        std::cout << "\n=== ALL CASES IN PRIORITY QUEUE ===" << std::endl;
+        int count = 1;
+        forEachInOrder([&count](const QueuedCase& c) {
+            std::cout << count++ << ". ";
+            c.displayCase();
+        });
+        std::cout << "===================================" << std::endl;
+    }
+
+    void displayPriorityOrder() const {
+        if (isEmpty()) {
+            std::cout << "No pending emergency cases." << std::endl;
+            return;
+        }
+
+        std::cout << "\n=== PENDING EMERGENCY CASES (Priority Order) ===" << std::endl;
+        int count = 1;
+        forEachInOrder([&count](const QueuedCase& c) {
+            std::cout << count++ << ". ";
+            c.displayCase();
+        });
         std::cout << "================================================" << std::endl;
     }
 };
 
+// Queue used by EmergencyDepartment: build with -DEMERGENCY_BUCKET_QUEUE for the
+// bucket queue, otherwise the binary heap
+#ifdef EMERGENCY_BUCKET_QUEUE
+typedef BucketPriorityQueue EmergencyQueue;
+#else
+typedef PriorityQueue EmergencyQueue;
+#endif
+
+// Every change is written to the log (<data file>.wal) before it is applied,
+// and refused if that write fails; the data file is the snapshot the log is
+// replayed on top of. With LogOptions::syncEvery == 1 (the default) a crash
+// loses nothing that was acknowledged; with a larger group the last
+// unsynced events can be lost to a power failure, though not to a process
+// crash, since every record is already handed to the OS.
 class EmergencyDepartment {
 private:
-    PriorityQueue emergencyQueue;
+    EmergencyQueue emergencyQueue;
     int nextCaseID;
     std::string dataFileName;
+    EmergencyLog journal;
     
     bool validatePriority(int priority) {
         return (priority >= 1 && priority <= 5);
     }
     
+    // Header line (next case ID, last event in the snapshot), then the
+    // pending cases in priority order
+    std::string buildSnapshot() const {
+        std::string snapshot = std::to_string(nextCaseID) + " " + std::to_string(journal.getLastSequence()) + "\n";
+        emergencyQueue.forEachInOrder([&snapshot](const QueuedCase& c) {
+            snapshot += c.toString();
+            snapshot += '\n';
+        });
+        return snapshot;
+    }
+    
+    // False (change must not be applied) if the event could not be logged
+    bool writeAhead(LogEvent& event) {
+        if (!journal.append(event)) {
+            std::cout << "Error: Cannot write to log file: " << dataFileName << ".wal"
+                      << ". Change not applied." << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // Reports a finished background compaction and starts one when the log
+    // has grown past its limit
+    void compactIfNeeded() {
+        std::string error = journal.takeError();
+        if (!error.empty()) {
+            std::cout << "Error: " << error << std::endl;
+        }
+        if (journal.shouldCompact()) {
+            journal.compact(dataFileName, buildSnapshot(), true);
+        }
+    }
+    
+    // Re-applies one logged event during recovery
+    void replay(const LogEvent& event) {
+        switch (event.type) {
+            case LogEvent::CASE_LOGGED:
+                if (validatePriority(event.priority) && !emergencyQueue.contains(event.caseID)) {
+                    EmergencyCase loggedCase(event.patientName, event.emergencyType, event.priority, event.caseID);
+                    loggedCase.setArrivalTimestamp(event.arrival);
+                    emergencyQueue.enqueue(loggedCase);
+                }
+                if (event.caseID >= nextCaseID) {
+                    nextCaseID = event.caseID + 1;
+                }
+                break;
+            case LogEvent::CASE_PROCESSED:
+            case LogEvent::CASE_REMOVED:
+                emergencyQueue.remove(event.caseID);
+                break;
+            case LogEvent::CASE_REPRIORITIZED:
+                if (validatePriority(event.priority)) {
+                    emergencyQueue.changePriority(event.caseID, event.priority);
+                }
+                break;
+        }
+    }
+    
 public:
-    EmergencyDepartment() : nextCaseID(1), dataFileName("emergency_department/emergency_data.txt") {}
+    EmergencyDepartment()
+        : nextCaseID(1), dataFileName("emergency_department/emergency_data.txt"),
+          journal(dataFileName + ".wal") {}
     
-    EmergencyDepartment(const std::string& filename) : nextCaseID(1), dataFileName(filename) {}
+    EmergencyDepartment(const std::string& filename, const LogOptions& logOptions = LogOptions())
+        : nextCaseID(1), dataFileName(filename), journal(filename + ".wal", logOptions) {}
     
     void logEmergencyCase(const std::string& patientName, const std::string& emergencyType, int priorityLevel) {
         if (patientName.empty()) {
@@ -278,6 +1395,13 @@ public:
         }
         
         EmergencyCase newCase(patientName, emergencyType, priorityLevel, nextCaseID);
+        LogEvent event(LogEvent::CASE_LOGGED, nextCaseID, priorityLevel);
+        event.arrival = newCase.getArrivalTimestamp();
+        event.patientName = patientName;
+        event.emergencyType = emergencyType;
+        if (!writeAhead(event)) {
+            return;
+        }
         emergencyQueue.enqueue(newCase);
         
         std::cout << "\n=== EMERGENCY CASE LOGGED SUCCESSFULLY ===" << std::endl;
@@ -285,6 +1409,7 @@ public:
         std::cout << "==========================================" << std::endl;
         
         nextCaseID++;
+        compactIfNeeded();
     }
     
     void processMostCriticalCase() {
@@ -293,6 +1418,10 @@ public:
             return;
         }
         
+        LogEvent event(LogEvent::CASE_PROCESSED, emergencyQueue.peek().getCaseID());
+        if (!writeAhead(event)) {
+            return;
+        }
         EmergencyCase criticalCase = emergencyQueue.dequeue();
         
         std::cout << "\n=== PROCESSING MOST CRITICAL CASE ===" << std::endl;
@@ -300,6 +1429,54 @@ public:
         std::cout << "This case is now being attended by emergency staff." << std::endl;
         std::cout << "Remaining cases in queue: " << emergencyQueue.getSize() << std::endl;
         std::cout << "=====================================" << std::endl;
+        compactIfNeeded();
+    }
+    
+    // Triage upgrade/downgrade of a waiting patient
+    void reprioritizeCase(int caseID, int newPriority) {
+        if (!validatePriority(newPriority)) {
+            std::cout << "Error: Priority level must be between 1 (Critical) and 5 (Minor)." << std::endl;
+            return;
+        }
+        
+        EmergencyCase pending;
+        if (!emergencyQueue.find(caseID, pending)) {
+            std::cout << "Error: No pending case with ID " << caseID << "." << std::endl;
+            return;
+        }
+        
+        int oldPriority = pending.getPriorityLevel();
+        LogEvent event(LogEvent::CASE_REPRIORITIZED, caseID, newPriority);
+        if (!writeAhead(event)) {
+            return;
+        }
+        emergencyQueue.changePriority(caseID, newPriority);
+        
+        std::cout << "\n=== CASE REPRIORITIZED ===" << std::endl;
+        std::cout << "Case " << caseID << ": priority " << oldPriority << " -> " << newPriority << std::endl;
+        std::cout << "==========================" << std::endl;
+        compactIfNeeded();
+    }
+    
+    // Patient left before treatment
+    void removeCase(int caseID) {
+        if (!emergencyQueue.contains(caseID)) {
+            std::cout << "Error: No pending case with ID " << caseID << "." << std::endl;
+            return;
+        }
+        
+        LogEvent event(LogEvent::CASE_REMOVED, caseID);
+        if (!writeAhead(event)) {
+            return;
+        }
+        EmergencyCase removed;
+        emergencyQueue.remove(caseID, &removed);
+        
+        std::cout << "\n=== CASE REMOVED FROM QUEUE ===" << std::endl;
+        removed.displayCase();
+        std::cout << "Remaining cases in queue: " << emergencyQueue.getSize() << std::endl;
+        std::cout << "===============================" << std::endl;
+        compactIfNeeded();
     }
     
     void viewPendingEmergencyCases() {
@@ -315,6 +1492,12 @@ public:
         return !emergencyQueue.isEmpty();
     }
     
+    // Anti-starvation: every `secondsPerLevel` seconds a case waits counts as
+    // one priority level more urgent; 0 (the default) turns aging off
+    void setAgingInterval(long long secondsPerLevel) {
+        emergencyQueue.setAging(secondsPerLevel);
+    }
+    
     int getPendingCasesCount() const {
         return emergencyQueue.getSize();
     }
@@ -332,69 +1515,123 @@ public:
         std::cout << "==================================" << std::endl;
     }
     
+    // Checkpoint: writes the snapshot now and empties the log. Not needed for
+    // durability (every change is already logged), only to keep recovery short.
     void saveToFile() {
-        std::ofstream outFile(dataFileName);
-        if (!outFile) {
-            std::cout << "Error: Cannot open file for writing: " << dataFileName << std::endl;
+        if (!journal.compact(dataFileName, buildSnapshot(), false)) {
+            std::cout << "Error: " << journal.takeError() << std::endl;
             return;
         }
         
-        outFile << nextCaseID << std::endl;
-        
-        PriorityQueue tempQueue = emergencyQueue;
-        while (!tempQueue.isEmpty()) {
-            EmergencyCase caseToSave = tempQueue.dequeue();
-            outFile << caseToSave.toString() << std::endl;
-        }
-        
-        outFile.close();
         std::cout << "Emergency department data saved to: " << dataFileName << std::endl;
         std::cout << "Next Case ID for future cases: " << nextCaseID << std::endl;
     }
     
+    // Recovery: loads the snapshot (the whole file read into one buffer, every
+    // line parsed in place, a single heapify), then replays the log events
+    // that came after it
     void loadFromFile() {
-        std::ifstream inFile(dataFileName);
+        unsigned long long snapshotSequence = 0;
+        loadSnapshot(snapshotSequence);
+        
+        int replayed = journal.recover(snapshotSequence, [this](const LogEvent& event) { replay(event); });
+        if (replayed > 0) {
+            std::cout << "Replayed " << replayed << " logged events. Pending cases: "
+                      << emergencyQueue.getSize() << ", Next Case ID: " << nextCaseID << std::endl;
+        }
+        if (journal.hasStaleLog()) {
+            saveToFile();
+        }
+    }
+    
+private:
+    // Leaves the queue in heap order with the snapshot's cases
+    void loadSnapshot(unsigned long long& snapshotSequence) {
+        emergencyQueue.clear();
+        nextCaseID = 1;
+        
+        std::ifstream inFile(dataFileName, std::ios::binary);
         if (!inFile) {
             std::cout << "No previous data found. Starting with new emergency department." << std::endl;
             return;
         }
 
-        while (!emergencyQueue.isEmpty()) {
-            emergencyQueue.dequeue();
+        inFile.seekg(0, std::ios::end);
+        std::streamoff fileSize = inFile.tellg();
+        inFile.seekg(0, std::ios::beg);
+        std::string buffer(fileSize > 0 ? static_cast<size_t>(fileSize) : 0, '\0');
+        if (fileSize > 0 && !inFile.read(&buffer[0], fileSize)) {
+            std::cout << "Error: Cannot read file: " << dataFileName << std::endl;
+            return;
         }
+        inFile.close();
 
-        std::string line;
-        
-        if (std::getline(inFile, line)) {
-            try {
-                nextCaseID = std::stoi(line);
-            } catch (const std::exception& e) {
-                std::cout << "Error reading next Case ID, resetting to 1" << std::endl;
-                nextCaseID = 1;
-            }
+        const char* data = buffer.data();
+        const char* dataEnd = data + buffer.size();
+        int lineCount = 0;
+        for (const char* p = data; p < dataEnd; p++) {
+            if (*p == '\n') lineCount++;
         }
+        emergencyQueue.reserve(lineCount + 1);
 
         int loadedCases = 0;
+        int skippedCases = 0;
         int maxID = 0;
-        while (std::getline(inFile, line)) {
-            if (!line.empty()) {
+        bool header = true;
+        const char* line = data;
+        while (line < dataEnd) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', dataEnd - line));
+            if (!lineEnd) lineEnd = dataEnd;
+            const char* next = lineEnd + 1;
+            if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+
+            if (header) {
+                header = false;
+                long long value;
+                const char* cursor = line;
+                bool valid = EmergencyCase::parseNumber(cursor, lineEnd, value);
+                if (valid) {
+                    nextCaseID = static_cast<int>(value);
+                    // Optional: sequence number of the last logged event included
+                    long long sequence;
+                    if (cursor < lineEnd && *cursor == ' ' &&
+                        EmergencyCase::parseNumber(++cursor, lineEnd, sequence) && sequence > 0) {
+                        snapshotSequence = static_cast<unsigned long long>(sequence);
+                    }
+                }
+                if (!valid || cursor != lineEnd) {
+                    std::cout << "Error reading next Case ID, resetting to 1" << std::endl;
+                    nextCaseID = 1;
+                }
+            } else if (lineEnd > line) {
                 EmergencyCase newCase;
-                newCase.fromString(line);
-                emergencyQueue.enqueue(newCase);
-                loadedCases++;
-                
-                if (newCase.getCaseID() >= maxID) {
-                    maxID = newCase.getCaseID();
+                if (!EmergencyCase::parseLine(line, lineEnd, newCase) ||
+                    !validatePriority(newCase.getPriorityLevel())) {
+                    skippedCases++;
+                } else {
+                    int id = newCase.getCaseID();
+                    if (!emergencyQueue.pushUnordered(std::move(newCase))) {
+                        std::cout << "Skipping duplicate case ID " << id << std::endl;
+                    } else {
+                        loadedCases++;
+                        if (id >= maxID) {
+                            maxID = id;
+                        }
+                    }
                 }
             }
+            line = next;
         }
+        emergencyQueue.heapify();
 
         // Ensure nextCaseID is higher than any loaded case
         if (maxID >= nextCaseID) {
             nextCaseID = maxID + 1;
         }
 
-        inFile.close();
+        if (skippedCases > 0) {
+            std::cout << "Skipped " << skippedCases << " malformed lines." << std::endl;
+        }
         std::cout << "Loaded " << loadedCases << " emergency cases. Next Case ID: " << nextCaseID << std::endl;
     }
 };
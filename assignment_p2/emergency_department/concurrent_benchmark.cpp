@@ -0,0 +1,247 @@
+// To run (from assignment_p2)
+// g++ -std=c++14 -O2 -pthread -o concurrent_benchmark emergency_department/concurrent_benchmark.cpp
+// ./concurrent_benchmark [producers] [consumers] [cases per producer] [shards]
+//
+// Triage desks (producers) log cases while clinicians (consumers) take them,
+// all at once: ConcurrentEmergencyQueue against one BucketPriorityQueue behind a
+// global mutex. Reports throughput and how far each dequeue strayed from strict
+// priority order, counted as the more urgent cases still waiting when it was taken.
+// Every enqueue and dequeue draws a stamp from one counter inside its critical
+// section; the stamped events are replayed in order after the run, so the count
+// is exact (always 0 for the global lock). A last run drives the same load
+// through ConcurrentEmergencyDepartment and checks each case is treated once.
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include "ConcurrentEmergencyQueue.hpp"
+
+// Baseline: the single-threaded queue made safe with one lock
+class LockedEmergencyQueue {
+private:
+    std::mutex lock;
+    BucketPriorityQueue queue;
+
+public:
+    explicit LockedEmergencyQueue(int) {}
+
+    long long enqueue(const EmergencyCase& newCase, std::atomic<long long>& clock) {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.enqueue(newCase);
+        return clock.fetch_add(1);
+    }
+
+    bool tryDequeue(EmergencyCase& out, std::atomic<long long>& clock, long long& stamp) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (queue.isEmpty()) {
+            return false;
+        }
+        out = queue.dequeue();
+        stamp = clock.fetch_add(1);
+        return true;
+    }
+
+    bool isEmpty() {
+        std::lock_guard<std::mutex> guard(lock);
+        return queue.isEmpty();
+    }
+};
+
+struct StressResult {
+    double seconds;
+    long long taken;
+    long long idSum;
+    long long deviationSum;     // more urgent cases waiting, summed over dequeues
+    long long inversions;       // dequeues with at least one more urgent case waiting
+    long long maxDeviation;
+
+    StressResult() : seconds(0), taken(0), idSum(0), deviationSum(0), inversions(0), maxDeviation(0) {}
+};
+
+struct ConsumerStats {
+    long long taken;
+    long long idSum;
+
+    ConsumerStats() : taken(0), idSum(0) {}
+};
+
+// Replays the stamped events (+priority for an enqueue, -priority for a
+// dequeue) in stamp order and counts the more urgent cases waiting at each dequeue
+void replayEvents(const std::vector<signed char>& events, StressResult& result) {
+    long long waiting[CaseStore::MAX_PRIORITY + 1] = {0};
+    for (size_t i = 0; i < events.size(); i++) {
+        int priority = events[i];
+        if (priority > 0) {
+            waiting[priority]++;
+            continue;
+        }
+        priority = -priority;
+        waiting[priority]--;
+        long long moreUrgent = 0;
+        for (int p = CaseStore::MIN_PRIORITY; p < priority; p++) {
+            moreUrgent += waiting[p];
+        }
+        result.deviationSum += moreUrgent;
+        if (moreUrgent > 0) result.inversions++;
+        if (moreUrgent > result.maxDeviation) result.maxDeviation = moreUrgent;
+    }
+}
+
+template <typename Queue>
+StressResult runStress(int producers, int consumers, int casesPerProducer, int shards) {
+    Queue queue(shards);
+    std::atomic<int> nextCaseID(1);
+    std::atomic<int> producersLeft(producers);
+    std::atomic<long long> clock(0);
+    std::vector<signed char> events(2 * static_cast<size_t>(producers) * casesPerProducer, 0);
+    std::vector<ConsumerStats> stats(consumers);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < producers; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::srand(1000 + t);
+            EmergencyCase c("Patient", "Injury", 5, 0);
+            for (int i = 0; i < casesPerProducer; i++) {
+                int priority = 1 + std::rand() % 5;
+                c.setCaseID(nextCaseID.fetch_add(1));
+                c.setPriorityLevel(priority);
+                events[queue.enqueue(c, clock)] = static_cast<signed char>(priority);
+            }
+            producersLeft.fetch_sub(1);
+        }));
+    }
+    for (int t = 0; t < consumers; t++) {
+        threads.push_back(std::thread([&, t]() {
+            ConsumerStats& s = stats[t];
+            EmergencyCase c;
+            long long stamp;
+            while (true) {
+                if (!queue.tryDequeue(c, clock, stamp)) {
+                    if (producersLeft.load() == 0 && queue.isEmpty()) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                events[stamp] = static_cast<signed char>(-c.getPriorityLevel());
+                s.taken++;
+                s.idSum += c.getCaseID();
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    StressResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (int t = 0; t < consumers; t++) {
+        result.taken += stats[t].taken;
+        result.idSum += stats[t].idSum;
+    }
+    replayEvents(events, result);
+    return result;
+}
+
+// Desks log cases and clinicians treat them through the department API; true
+// if every logged case was treated exactly once
+bool runDepartment(int producers, int consumers, int casesPerProducer, int shards, double& seconds) {
+    ConcurrentEmergencyDepartment department(shards);
+    std::atomic<int> producersLeft(producers);
+    std::atomic<bool> rejected(false);
+    long long expectedCases = static_cast<long long>(producers) * casesPerProducer;
+    std::vector<std::atomic<unsigned char> > treated(static_cast<size_t>(expectedCases) + 1);
+    for (size_t i = 0; i < treated.size(); i++) {
+        treated[i] = 0;
+    }
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < producers; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::srand(2000 + t);
+            for (int i = 0; i < casesPerProducer; i++) {
+                if (department.logEmergencyCase("Patient", "Injury", 1 + std::rand() % 5) == 0) {
+                    rejected = true;
+                }
+            }
+            producersLeft.fetch_sub(1);
+        }));
+    }
+    for (int t = 0; t < consumers; t++) {
+        threads.push_back(std::thread([&]() {
+            EmergencyCase c;
+            while (true) {
+                if (!department.processMostCriticalCase(c)) {
+                    if (producersLeft.load() == 0 && !department.hasPendingCases()) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                int id = c.getCaseID();
+                if (id >= 1 && id <= expectedCases) {
+                    treated[id].fetch_add(1);
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool allOnce = !rejected;
+    for (size_t id = 1; id < treated.size() && allOnce; id++) {
+        allOnce = treated[id] == 1;
+    }
+    return allOnce;
+}
+
+void printResult(const char* name, const StressResult& r, long long expectedCases) {
+    long long expectedIdSum = expectedCases * (expectedCases + 1) / 2;
+    double taken = r.taken > 0 ? static_cast<double>(r.taken) : 1.0;
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(9) << r.seconds << " s"
+              << std::setprecision(2) << std::setw(12) << 2.0 * r.taken / r.seconds / 1e6 << " Mops/s"
+              << std::setw(12) << r.deviationSum / taken
+              << std::setw(10) << r.maxDeviation
+              << std::setw(11) << 100.0 * r.inversions / taken << " %"
+              << "   " << (r.taken == expectedCases && r.idSum == expectedIdSum ? "all cases" : "LOST CASES")
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int producers = argc > 1 ? std::atoi(argv[1]) : 4;
+    int consumers = argc > 2 ? std::atoi(argv[2]) : 4;
+    int casesPerProducer = argc > 3 ? std::atoi(argv[3]) : 250000;
+    int shards = argc > 4 ? std::atoi(argv[4]) : 0;
+    if (producers < 1 || consumers < 1 || casesPerProducer < 1) {
+        std::cout << "Error: producers, consumers and cases must be at least 1" << std::endl;
+        return 1;
+    }
+
+    long long expectedCases = static_cast<long long>(producers) * casesPerProducer;
+    ConcurrentEmergencyQueue probe(shards);
+    std::cout << "=== CONCURRENT QUEUE STRESS (" << producers << " desks, " << consumers << " clinicians, "
+              << expectedCases << " cases, " << probe.getShardCount() << " shards, "
+              << std::thread::hardware_concurrency() << " hardware threads) ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "Queue" << std::right << std::setw(11) << "Time"
+              << std::setw(19) << "Throughput" << std::setw(12) << "Mean dev"
+              << std::setw(10) << "Max dev" << std::setw(13) << "Inverted" << std::endl;
+
+    printResult("Global lock", runStress<LockedEmergencyQueue>(producers, consumers, casesPerProducer, shards),
+                expectedCases);
+    printResult("Sharded", runStress<ConcurrentEmergencyQueue>(producers, consumers, casesPerProducer, shards),
+                expectedCases);
+    std::cout << "Mean/Max dev: more urgent cases still waiting when a case was taken" << std::endl;
+
+    double seconds = 0;
+    bool allOnce = runDepartment(producers, consumers, casesPerProducer, shards, seconds);
+    std::cout << "Department API: " << expectedCases << " cases logged and treated in " << std::setprecision(3)
+              << seconds << " s, " << (allOnce ? "each treated once" : "CASES LOST OR TREATED TWICE") << std::endl;
+    return 0;
+}
@@ -12,9 +12,11 @@ void displayMenu() {
     std::cout << "5. Save Data" << std::endl;
     std::cout << "6. Load Data" << std::endl;
     std::cout << "7. Add Sample Data (10 Cases)" << std::endl;
-    std::cout << "8. Exit" << std::endl;
+    std::cout << "8. Reprioritize Case" << std::endl;
+    std::cout << "9. Remove Case (Patient Left)" << std::endl;
+    std::cout << "10. Exit" << std::endl;
     std::cout << "=============================================" << std::endl;
-    std::cout << "Enter your choice (1-8): ";
+    std::cout << "Enter your choice (1-10): ";
 }
 
 void addSampleData(EmergencyDepartment& dept) {
@@ -45,6 +47,7 @@ void emergency_department() {
     int choice;
     std::string name, type;
     int priority;
+    int caseID;
 
     do {
         displayMenu();
@@ -54,7 +57,7 @@ void emergency_department() {
         if (std::cin.fail()) {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Invalid input! Please enter a number between 1-8." << std::endl;
+            std::cout << "Invalid input! Please enter a number between 1-10." << std::endl;
             continue;
         }
 
@@ -104,14 +107,42 @@ void emergency_department() {
                 break;
 
             case 8:
+                std::cout << "Enter case ID: ";
+                std::cin >> caseID;
+                std::cout << "Enter new priority level (1-Critical to 5-Minor): ";
+                std::cin >> priority;
+
+                if (std::cin.fail()) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid input!" << std::endl;
+                } else {
+                    dept.reprioritizeCase(caseID, priority);
+                }
+                break;
+
+            case 9:
+                std::cout << "Enter case ID: ";
+                std::cin >> caseID;
+
+                if (std::cin.fail()) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid case ID!" << std::endl;
+                } else {
+                    dept.removeCase(caseID);
+                }
+                break;
+
+            case 10:
                 dept.saveToFile();
                 std::cout << "Thank you for using Emergency Department System!" << std::endl;
                 std::cout << "Data saved successfully. Goodbye!" << std::endl;
                 break;
 
             default:
-                std::cout << "Invalid choice! Please enter a number between 1-8." << std::endl;
+                std::cout << "Invalid choice! Please enter a number between 1-10." << std::endl;
         }
 
-    } while (choice != 8);
+    } while (choice != 10);
 }
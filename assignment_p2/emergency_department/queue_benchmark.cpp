@@ -0,0 +1,462 @@
+// To run (from assignment_p2)
+// g++ -std=c++14 -O2 -pthread -o queue_benchmark emergency_department/queue_benchmark.cpp
+// ./queue_benchmark [operations]
+//
+// Binary heap (PriorityQueue) vs bucket queue (BucketPriorityQueue) on the same
+// random triage workload: a bulk fill then drain, and a steady mixed stream.
+// Also times EmergencyDepartment::loadFromFile on a saved backlog of the same size,
+// and the cost per logged case of the write-ahead log against a full save.
+// Finally, aging: a standing backlog under a stream of urgent arrivals, with and
+// without aging, to show whether low-priority cases are ever seen, followed by
+// order checks of both queues against a brute-force reference (aging, re-triage
+// and removal).
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "HospitalEmergency.hpp"
+
+struct BenchmarkResult {
+    double bulkSeconds;
+    double mixedSeconds;
+    long long fifoViolations;   // equal-priority cases that left out of arrival order
+    long long checksum;         // dequeued priority sequence, must match between queues
+};
+
+// Tracks the last dequeued ID per priority to count FIFO violations
+// and fingerprint the sequence of dequeued priorities (tie-breaking aside, both
+// queues must hand out the same priorities in the same order)
+struct OrderCheck {
+    int lastID[6];
+    long long violations;
+    long long checksum;
+    long long position;
+
+    OrderCheck() : violations(0), checksum(0), position(0) {
+        for (int p = 0; p < 6; p++) lastID[p] = 0;
+    }
+
+    void record(const EmergencyCase& c) {
+        int p = c.getPriorityLevel();
+        if (c.getCaseID() < lastID[p]) violations++;
+        lastID[p] = c.getCaseID();
+        checksum += ++position * p;
+    }
+};
+
+// Cases are stamped from one template so the timing is queue work, not
+// string and clock formatting per arrival
+EmergencyCase makeCase(const EmergencyCase& base, int id) {
+    EmergencyCase c = base;
+    c.setCaseID(id);
+    c.setPriorityLevel(1 + std::rand() % 5);
+    return c;
+}
+
+template <typename Queue>
+BenchmarkResult runQueue(int operations) {
+    BenchmarkResult result;
+    OrderCheck check;
+    std::srand(12345);
+    int nextID = 1;
+    EmergencyCase base("Patient", "Injury", 5, 0);
+
+    // Bulk: half the operations fill the queue, half drain it
+    Queue bulk;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations / 2; i++) {
+        bulk.enqueue(makeCase(base, nextID++));
+    }
+    while (!bulk.isEmpty()) {
+        check.record(bulk.dequeue());
+    }
+    result.bulkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Mixed: a standing queue of 1000 with one arrival per treatment. IDs restart
+    // so the order check only compares cases of this phase.
+    OrderCheck mixedCheck;
+    Queue mixed;
+    nextID = 1;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        mixed.enqueue(makeCase(base, nextID++));
+    }
+    for (int i = 0; i < operations; i++) {
+        if (i % 2 == 0) {
+            mixed.enqueue(makeCase(base, nextID++));
+        } else {
+            mixedCheck.record(mixed.dequeue());
+        }
+    }
+    result.mixedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.fifoViolations = check.violations + mixedCheck.violations;
+    result.checksum = check.checksum + mixedCheck.checksum;
+    return result;
+}
+
+void printResult(const char* name, const BenchmarkResult& r) {
+    std::cout << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << r.bulkSeconds << " s" << std::setw(10) << r.mixedSeconds << " s"
+              << std::setw(18) << r.fifoViolations << std::endl;
+}
+
+// Writes `count` cases in the saved-data format and times loading them back
+void runLoadBenchmark(int count) {
+    const char* path = "queue_benchmark_cases.txt";
+    {
+        std::ofstream out(path);
+        out << count + 1 << "\n";
+        EmergencyCase c("Patient", "Heart Attack", 1, 0);
+        for (int i = 1; i <= count; i++) {
+            c.setCaseID(i);
+            c.setPriorityLevel(1 + std::rand() % 5);
+            out << c.toString() << "\n";
+        }
+    }
+
+    EmergencyDepartment dept(path);
+    auto start = std::chrono::steady_clock::now();
+    dept.loadFromFile();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::remove(path);
+    std::remove((std::string(path) + ".wal").c_str());
+
+    std::cout << "Bulk load of " << count << " saved cases: " << std::setprecision(3) << seconds
+              << " s (" << dept.getPendingCasesCount() << " pending)" << std::endl;
+}
+
+void removeDepartmentFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".wal.old").c_str());
+}
+
+// Logs `count` cases with the given group-commit size and returns microseconds
+// per case; the department's console output is discarded meanwhile
+double timeLogging(const std::string& path, int syncEvery, int count, double* saveSeconds) {
+    removeDepartmentFiles(path);
+    LogOptions options;
+    options.syncEvery = syncEvery;
+    options.compactBytes = 0;
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+    double perCase;
+    {
+        EmergencyDepartment dept(path, options);
+        dept.loadFromFile();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            dept.logEmergencyCase("Patient", "Injury", 1 + std::rand() % 5);
+        }
+        perCase = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / count;
+        if (saveSeconds) {
+            start = std::chrono::steady_clock::now();
+            dept.saveToFile();
+            *saveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    std::cout.rdbuf(console);
+    removeDepartmentFiles(path);
+    return perCase;
+}
+
+void runLogBenchmark(int count) {
+    const std::string path = "queue_benchmark_log.txt";
+    double saveSeconds = 0;
+    std::cout << "Write-ahead log, per logged case: " << std::setprecision(2)
+              << timeLogging(path, 0, count, &saveSeconds) << " us (no fsync), "
+              << timeLogging(path, 64, count, NULL) << " us (fsync every 64), "
+              << timeLogging(path, 1, count < 2000 ? count : 2000, NULL) << " us (fsync every case)" << std::endl;
+    std::cout << "Full save of " << count << " pending cases: " << std::setprecision(3)
+              << saveSeconds << " s" << std::endl;
+}
+
+struct AgingResult {
+    double seconds;
+    long long lowServed;     // priority 4-5 cases treated during the stream
+    long long longestWait;   // longest wait of any treated case, seconds
+    long long oldestLeft;    // longest wait among cases still queued at the end
+    long long idSum;         // dequeued IDs weighted by position, must match between queues
+};
+
+// `pending` cases wait when a stream of `steps` arrivals (90% priority 1-2, one
+// per simulated second) meets one treatment per arrival
+template <typename Queue>
+AgingResult runAging(int pending, int steps, long long agingSeconds) {
+    Queue queue;
+    queue.setAging(agingSeconds);
+    std::srand(777);
+    long long now = 1700000000;
+    EmergencyCase c("Patient", "Injury", 5, 0);
+    int nextID = 1;
+    for (int i = 0; i < pending; i++) {
+        c.setCaseID(nextID++);
+        c.setPriorityLevel(1 + std::rand() % 5);
+        c.setArrivalTimestamp(++now);
+        queue.enqueue(c);
+    }
+
+    AgingResult result = AgingResult();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) {
+        now++;
+        c.setCaseID(nextID++);
+        c.setPriorityLevel(std::rand() % 10 < 9 ? 1 + std::rand() % 2 : 3 + std::rand() % 3);
+        c.setArrivalTimestamp(now);
+        queue.enqueue(c);
+        EmergencyCase treated = queue.dequeue();
+        long long waited = now - treated.getArrivalTimestamp();
+        if (treated.getPriorityLevel() >= 4) result.lowServed++;
+        if (waited > result.longestWait) result.longestWait = waited;
+        result.idSum += static_cast<long long>(i + 1) * treated.getCaseID();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    queue.forEachInOrder([&result, now](const QueuedCase& q) {
+        if (now - q.getArrivalTimestamp() > result.oldestLeft) {
+            result.oldestLeft = now - q.getArrivalTimestamp();
+        }
+    });
+    return result;
+}
+
+// Brute-force reference for the queue order: a plain array searched on every
+// dequeue, with the aging anchor rule of CaseStore::joinLevel written out again
+class ReferenceQueue {
+private:
+    struct Entry {
+        int caseID;
+        int priority;
+        long long agingFrom;
+        long long seq;
+    };
+
+    std::vector<Entry> cases;
+    long long levelAnchor[6];
+    long long nextSeq;
+    long long agingSeconds;
+
+    long long joinLevel(int priority, long long anchor) {
+        if (anchor < levelAnchor[priority]) {
+            anchor = levelAnchor[priority];
+        }
+        levelAnchor[priority] = anchor;
+        return anchor;
+    }
+
+    bool before(const Entry& a, const Entry& b) const {
+        if (agingSeconds > 0) {
+            long long keyA = a.agingFrom + (a.priority - 1) * agingSeconds;
+            long long keyB = b.agingFrom + (b.priority - 1) * agingSeconds;
+            if (keyA != keyB) return keyA < keyB;
+        } else if (a.priority != b.priority) {
+            return a.priority < b.priority;
+        }
+        return a.seq < b.seq;
+    }
+
+    int find(int caseID) const {
+        for (size_t i = 0; i < cases.size(); i++) {
+            if (cases[i].caseID == caseID) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+public:
+    explicit ReferenceQueue(long long secondsPerLevel) : nextSeq(0), agingSeconds(secondsPerLevel) {
+        for (int p = 0; p < 6; p++) levelAnchor[p] = std::numeric_limits<long long>::min();
+    }
+
+    void enqueue(int caseID, int priority, long long arrival) {
+        Entry e = { caseID, priority, joinLevel(priority, arrival), nextSeq++ };
+        cases.push_back(e);
+    }
+
+    void changePriority(int caseID, int priority) {
+        Entry& e = cases[find(caseID)];
+        e.priority = priority;
+        e.agingFrom = joinLevel(priority, e.agingFrom);
+        e.seq = nextSeq++;
+    }
+
+    void remove(int caseID) {
+        cases.erase(cases.begin() + find(caseID));
+    }
+
+    // Pending case IDs in dequeue order
+    std::vector<int> order() const {
+        std::vector<Entry> sorted = cases;
+        std::sort(sorted.begin(), sorted.end(), [this](const Entry& a, const Entry& b) { return before(a, b); });
+        std::vector<int> ids;
+        for (size_t i = 0; i < sorted.size(); i++) ids.push_back(sorted[i].caseID);
+        return ids;
+    }
+
+    int dequeue() {
+        size_t best = 0;
+        for (size_t i = 1; i < cases.size(); i++) {
+            if (before(cases[i], cases[best])) best = i;
+        }
+        int caseID = cases[best].caseID;
+        cases.erase(cases.begin() + best);
+        return caseID;
+    }
+
+    int pendingAt(size_t i) const { return cases[i].caseID; }
+    int getSize() const { return static_cast<int>(cases.size()); }
+};
+
+template <typename Queue>
+std::vector<int> queueOrder(const Queue& queue) {
+    std::vector<int> ids;
+    queue.forEachInOrder([&ids](const QueuedCase& c) { ids.push_back(c.getCaseID()); });
+    return ids;
+}
+
+// Reported re-triage repro, aging 100 s: (id, priority, arrival) = (1,5,0),
+// (2,3,150), (3,4,160), (4,4,170), then case 1 moves to priority 4. Case 1 ages
+// from when it joined level 4, so it leaves last: 2 3 4 1
+template <typename Queue>
+std::string retriageReproOrder() {
+    Queue queue;
+    queue.setAging(100);
+    const int cases[4][3] = { {1, 5, 0}, {2, 3, 150}, {3, 4, 160}, {4, 4, 170} };
+    EmergencyCase c("Patient", "Injury", 5, 0);
+    for (int i = 0; i < 4; i++) {
+        c.setCaseID(cases[i][0]);
+        c.setPriorityLevel(cases[i][1]);
+        c.setArrivalTimestamp(cases[i][2]);
+        queue.enqueue(c);
+    }
+    queue.changePriority(1, 4);
+    std::string order;
+    while (!queue.isEmpty()) {
+        order += (order.empty() ? "" : " ") + std::to_string(queue.dequeue().getCaseID());
+    }
+    return order;
+}
+
+void runRetriageRepro() {
+    std::string heap = retriageReproOrder<PriorityQueue>();
+    std::string bucket = retriageReproOrder<BucketPriorityQueue>();
+    bool ok = heap == "2 3 4 1" && bucket == "2 3 4 1";
+    std::cout << "Re-triage repro (expect 2 3 4 1): heap " << heap << ", bucket " << bucket
+              << (ok ? "" : "   MISMATCH") << std::endl;
+}
+
+// Random arrivals (clock sometimes stepping back), re-triage, removals and
+// treatments on both queues and the reference, with and without aging; every
+// dequeued ID and, now and then, the whole forEachInOrder listing must agree
+void runReferenceCheck(int rounds, int operations) {
+    std::srand(4242);
+    const long long agingChoices[3] = { 0, 100, 1800 };
+    long long dequeues = 0;
+    long long mismatches = 0;
+    EmergencyCase c("Patient", "Injury", 5, 0);
+    for (int round = 0; round < rounds; round++) {
+        long long aging = agingChoices[round % 3];
+        PriorityQueue heap;
+        BucketPriorityQueue bucket;
+        ReferenceQueue reference(aging);
+        heap.setAging(aging);
+        bucket.setAging(aging);
+        long long now = 1700000000;
+        int nextID = 1;
+        for (int op = 0; op < operations; op++) {
+            int action = std::rand() % 10;
+            if (action < 4 || reference.getSize() == 0) {
+                now += std::rand() % 120 - 20;
+                int priority = 1 + std::rand() % 5;
+                c.setCaseID(nextID);
+                c.setPriorityLevel(priority);
+                c.setArrivalTimestamp(now);
+                heap.enqueue(c);
+                bucket.enqueue(c);
+                reference.enqueue(nextID++, priority, now);
+            } else if (action < 6) {
+                int caseID = reference.pendingAt(std::rand() % reference.getSize());
+                int priority = 1 + std::rand() % 5;
+                heap.changePriority(caseID, priority);
+                bucket.changePriority(caseID, priority);
+                reference.changePriority(caseID, priority);
+            } else if (action < 7) {
+                int caseID = reference.pendingAt(std::rand() % reference.getSize());
+                heap.remove(caseID);
+                bucket.remove(caseID);
+                reference.remove(caseID);
+            } else {
+                int expected = reference.dequeue();
+                if (heap.dequeue().getCaseID() != expected) mismatches++;
+                if (bucket.dequeue().getCaseID() != expected) mismatches++;
+                dequeues++;
+            }
+            if (op % 250 == 0) {
+                std::vector<int> expected = reference.order();
+                if (queueOrder(heap) != expected) mismatches++;
+                if (queueOrder(bucket) != expected) mismatches++;
+            }
+        }
+    }
+    std::cout << "Randomized order check vs reference (aging, re-triage, removal): " << dequeues
+              << " dequeues, " << mismatches << " mismatches" << std::endl;
+}
+
+void runAgingBenchmark(int pending, int steps) {
+    const long long agingSeconds = 1800;   // half an hour of waiting = one level
+    std::cout << "\n=== AGING (" << pending << " pending, " << steps << " urgent-heavy arrivals, "
+              << agingSeconds << " s per level) ===" << std::endl;
+    std::cout << std::left << std::setw(22) << "Queue" << std::right << std::setw(12) << "us/op"
+              << std::setw(14) << "P4-5 served" << std::setw(16) << "Longest wait" << std::setw(16) << "Oldest left" << std::endl;
+
+    const char* names[4] = { "Binary heap", "Binary heap + aging", "Bucket queue", "Bucket queue + aging" };
+    AgingResult results[4] = {
+        runAging<PriorityQueue>(pending, steps, 0),
+        runAging<PriorityQueue>(pending, steps, agingSeconds),
+        runAging<BucketPriorityQueue>(pending, steps, 0),
+        runAging<BucketPriorityQueue>(pending, steps, agingSeconds)
+    };
+    for (int i = 0; i < 4; i++) {
+        std::cout << std::left << std::setw(22) << names[i] << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << results[i].seconds * 1e6 / (2.0 * steps)
+                  << std::setw(14) << results[i].lowServed
+                  << std::setw(14) << results[i].longestWait << " s"
+                  << std::setw(14) << results[i].oldestLeft << " s" << std::endl;
+    }
+    std::cout << "Same aged order: " << (results[1].idSum == results[3].idSum ? "yes" : "NO") << std::endl;
+    runRetriageRepro();
+    runReferenceCheck(200, 2000);
+}
+
+int main(int argc, char* argv[]) {
+    int operations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (operations < 2) {
+        std::cout << "Error: operations must be at least 2" << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== EMERGENCY QUEUE BENCHMARK (" << operations << " operations per phase) ===" << std::endl;
+    std::cout << std::left << std::setw(14) << "Queue" << std::right << std::setw(12) << "Fill+drain"
+              << std::setw(12) << "Mixed" << std::setw(18) << "FIFO violations" << std::endl;
+
+    BenchmarkResult heap = runQueue<PriorityQueue>(operations);
+    printResult("Binary heap", heap);
+    BenchmarkResult bucket = runQueue<BucketPriorityQueue>(operations);
+    printResult("Bucket queue", bucket);
+
+    std::cout << "Speedup: " << std::setprecision(1) << heap.bulkSeconds / bucket.bulkSeconds << "x fill+drain, "
+              << heap.mixedSeconds / bucket.mixedSeconds << "x mixed" << std::endl;
+    std::cout << "Same priority order: " << (heap.checksum == bucket.checksum ? "yes" : "NO") << std::endl;
+    std::cout << "Bytes moved per queued case: " << sizeof(CaseRecord) << " (EmergencyCase: "
+              << sizeof(EmergencyCase) << ")" << std::endl;
+
+    runLoadBenchmark(operations);
+    runLogBenchmark(operations / 10 > 0 ? operations / 10 : 1);
+    runAgingBenchmark(100000, operations);
+    return 0;
+}
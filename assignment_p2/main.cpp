@@ -1,5 +1,5 @@
 // To run
-// g++ -std=c++14 -o main main.cpp ambulance_dispatcher/ambulance_dispatcher.cpp patient_admission/patient_admission.cpp medical_supply/medical_supply.cpp emergency_department/emergency_department.cpp
+// g++ -std=c++14 -pthread -o main main.cpp ambulance_dispatcher/ambulance_dispatcher.cpp patient_admission/patient_admission.cpp medical_supply/medical_supply.cpp emergency_department/emergency_department.cpp
 // ./main
 
 #include <iostream>